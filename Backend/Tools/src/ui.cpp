@@ -3,6 +3,7 @@
 #include "imgui_impl_win32.h"
 #include "imgui_impl_dx11.h"
 #include "imgui_internal.h"
+#include "profiler.h"
 #include <d3d11.h>
 #include <tchar.h>
 #include <cmath>
@@ -204,20 +205,25 @@ void DebugInterface::show() {
             updateData();
         }
 
-        // 开始新帧
-        ImGui_ImplDX11_NewFrame();
-        ImGui_ImplWin32_NewFrame();
-        ImGui::NewFrame();
+        {
+            // 计时不含 Present（垂直同步等待）
+            PROFILE_ZONE("render");
 
-        // 渲染调试界面
-        renderImGui();
+            // 开始新帧
+            ImGui_ImplDX11_NewFrame();
+            ImGui_ImplWin32_NewFrame();
+            ImGui::NewFrame();
 
-        // 渲染
-        ImGui::Render();
-        const float clear_color_with_alpha[4] = { 0.98f, 0.98f, 0.98f, 1.0f };
-        g_pd3dDeviceContextDebug->OMSetRenderTargets(1, &g_mainRenderTargetViewDebug, nullptr);
-        g_pd3dDeviceContextDebug->ClearRenderTargetView(g_mainRenderTargetViewDebug, clear_color_with_alpha);
-        ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+            // 渲染调试界面
+            renderImGui();
+
+            // 渲染
+            ImGui::Render();
+            const float clear_color_with_alpha[4] = { 0.98f, 0.98f, 0.98f, 1.0f };
+            g_pd3dDeviceContextDebug->OMSetRenderTargets(1, &g_mainRenderTargetViewDebug, nullptr);
+            g_pd3dDeviceContextDebug->ClearRenderTargetView(g_mainRenderTargetViewDebug, clear_color_with_alpha);
+            ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+        }
 
         g_pSwapChainDebug->Present(1, 0);
     }
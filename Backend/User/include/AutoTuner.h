@@ -0,0 +1,86 @@
+#ifndef AUTO_TUNER_H
+#define AUTO_TUNER_H
+
+#include "include/PidController.h"
+#include "include/PlantIdentifier.h"
+
+// 自整定：继电反馈实验或基于辨识模型的 SIMC 规则，计算速度环 / 角度环参数
+// 实验在控制线程中逐周期推进，结束时在同一周期内把参数写回 PIDController
+class AutoTuner {
+public:
+    enum class State {
+        IDLE,
+        RUNNING,
+        DONE,
+        ABORTED
+    };
+
+    // 实验期间的安全限制
+    struct Limits {
+        float maxTorque = 0.5f;   // 力矩上限（Nm）
+        float maxOmega = 60.0f;   // 角速度上限（rad/s）
+        float maxTravel = 720.0f; // 相对起点的最大转角（度）
+        float timeout = 10.0f;    // 超时（秒）
+    };
+
+    struct RelayConfig {
+        float amplitude = 0.3f;   // 继电幅值（Nm）
+        float hysteresis = 0.2f;  // 滞环宽度（rad/s）
+        float setpoint = 0.0f;    // 速度设定（rad/s）
+        int cycles = 4;           // 用于统计的振荡周期数（不含第一个过渡周期）
+    };
+
+    struct Result {
+        bool valid = false;
+        float ultimateGain = 0.0f;    // 临界增益 Ku（继电实验）
+        float ultimatePeriod = 0.0f;  // 临界周期 Pu（秒）
+        float speedKp = 0.0f;
+        float speedKi = 0.0f;
+        float angleKp = 0.0f;         // 角度环输出为速度参考（rad/s / 度）
+        float angleKi = 0.0f;
+    };
+
+    AutoTuner() = default;
+
+    // 基于辨识模型的 SIMC 整定，tauC 为期望速度闭环时间常数（<=0 时取有效延时）
+    [[nodiscard]] static Result tuneFromModel(const PlantModel& model, float dt, float tauC = 0.0f);
+
+    // 开始继电反馈实验
+    bool startRelay(const RelayConfig& config);
+    bool startRelay(const RelayConfig& config, const Limits& limits);
+    void abort();
+
+    // 实验运行时每个控制周期调用一次，返回本周期应下发的力矩
+    float update(float omega, float angleDeg, float dt);
+
+    [[nodiscard]] State state() const;
+    [[nodiscard]] bool isRunning() const;
+    [[nodiscard]] const Result& result() const;
+
+    // 写回参数并清空积分，须在控制线程中调用，保证与 compute 不交错
+    static bool apply(const Result& result, PIDController& speedController, PIDController* angleController);
+
+private:
+    void finish();
+
+    RelayConfig relay_;
+    Limits limits_;
+    Result result_;
+    State state_ = State::IDLE;
+
+    float elapsed_ = 0.0f;
+    float travel_ = 0.0f;
+    float lastAngle_ = 0.0f;
+    bool hasAngle_ = false;
+
+    float output_ = 0.0f;
+    float lastSwitchTime_ = -1.0f;
+    float cycleMax_ = 0.0f;
+    float cycleMin_ = 0.0f;
+    int switches_ = 0;
+    int measuredCycles_ = 0;
+    float periodSum_ = 0.0f;
+    float amplitudeSum_ = 0.0f;
+};
+
+#endif // AUTO_TUNER_H
@@ -0,0 +1,88 @@
+#ifndef BASIC_PID_CONTROLLER_H
+#define BASIC_PID_CONTROLLER_H
+
+#include "include/FixedPoint.h"
+
+// 按数值类型模板化的 PID，用于在上位机复现单片机上的定点控制律
+// T 可为 float / double / Fixed<...>，dt 在设置参数时折算进 ki、kd，
+// 计算过程只有乘加与比较，与固件中的写法一一对应
+template<typename T>
+class BasicPIDController {
+public:
+    BasicPIDController(float kp, float ki, float kd, float dt,
+                       float outputMin, float outputMax, float integralMax) {
+        setGains(kp, ki, kd, dt);
+        setLimits(outputMin, outputMax);
+        limitsSaturated_ = !convert(integralMax, integralMax_) || limitsSaturated_;
+    }
+
+    // 参数换算：ki * dt、kd / dt 在此一次性完成。
+    // 定点类型下换算结果超出 Q 格式范围（或为 NaN）时照常饱和，但返回 false 并置位 saturated()
+    bool setGains(float kp, float ki, float kd, float dt) {
+        const bool exact = convert(kp, kp_) & convert(ki * dt, kiDt_) & convert(kd / dt, kdDivDt_);
+        gainsSaturated_ = !exact;
+        return exact;
+    }
+
+    bool setLimits(float outputMin, float outputMax) {
+        const bool exact = convert(outputMin, outputMin_) & convert(outputMax, outputMax_);
+        limitsSaturated_ = !exact;
+        return exact;
+    }
+
+    T compute(T setpoint, T measurement) {
+        const T error = setpoint - measurement;
+
+        // 积分项
+        integral_ = clamp(integral_ + kiDt_ * error, -integralMax_, integralMax_);
+
+        // 微分项
+        const T derivative = kdDivDt_ * (error - lastError_);
+        lastError_ = error;
+
+        // 计算输出并限幅
+        return clamp(kp_ * error + integral_ + derivative, outputMin_, outputMax_);
+    }
+
+    void reset() {
+        integral_ = T(0);
+        lastError_ = T(0);
+    }
+
+    [[nodiscard]] T integral() const { return integral_; }
+    // 最近一次 setGains / setLimits（含构造）是否有参数被饱和
+    [[nodiscard]] bool saturated() const { return gainsSaturated_ || limitsSaturated_; }
+
+private:
+    static bool convert(float value, T& out) {
+        if constexpr (std::is_floating_point_v<T>) {
+            out = T(value);
+            return value == value;
+        } else {
+            return T::tryFromDouble(static_cast<double>(value), out);
+        }
+    }
+
+    static T clamp(T value, T lo, T hi) {
+        return value < lo ? lo : (hi < value ? hi : value);
+    }
+
+    T kp_{};
+    T kiDt_{};
+    T kdDivDt_{};
+    T outputMin_{};
+    T outputMax_{};
+    T integralMax_{};
+    T integral_{};
+    T lastError_{};
+    bool gainsSaturated_ = false;
+    bool limitsSaturated_ = false;
+};
+
+using PIDControllerF32 = BasicPIDController<float>;
+using PIDControllerF64 = BasicPIDController<double>;
+using PIDControllerQ15 = BasicPIDController<q15_t>;
+using PIDControllerQ31 = BasicPIDController<q31_t>;
+using PIDControllerQ16 = BasicPIDController<q16_16_t>;
+
+#endif // BASIC_PID_CONTROLLER_H
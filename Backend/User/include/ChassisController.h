@@ -0,0 +1,82 @@
+#ifndef CHASSIS_CONTROLLER_H
+#define CHASSIS_CONTROLLER_H
+
+#include <array>
+#include "kinematics.h"
+#include "motor_group.h"
+#include "include/PidController.h"
+
+// 麦克纳姆底盘：体速度 -> 逆运动学 -> 各轮速度环 -> 整组一次发布。
+// 组成员顺序须与 MecanumKinematics 一致（左前、右前、左后、右后）
+class MecanumController {
+public:
+    MecanumController(MotorGroup& group, const MecanumKinematics& kinematics, const PIDController& wheel);
+
+    // 各轮安装方向（±1），电机正转使车前进为 +1
+    void setDirections(const std::array<float, 4>& directions);
+
+    // 控制周期内调用；组成员数不为 4 时返回 false 且不下发
+    bool update(const BodyTwist& command, float dt);
+    // 上一次 update 时由轮速正解得到的实际体速度
+    [[nodiscard]] BodyTwist odometry() const;
+
+    void reset();
+
+private:
+    MotorGroup& group_;
+    MecanumKinematics kinematics_;
+    std::array<PIDController, 4> wheels_;
+    std::array<float, 4> directions_;
+    BodyTwist odometry_;
+};
+
+// 四舵轮底盘：组成员顺序为 转向 0..3、驱动 0..3（模块顺序同 SwerveKinematics）。
+// 转向为角度环串速度环，驱动为速度环，驱动速度按朝向误差的余弦缩小，转到位前不全速推进
+class SwerveController {
+public:
+    SwerveController(MotorGroup& group, const SwerveKinematics& kinematics,
+                     const PIDController& steerAngle, const PIDController& steerSpeed, const PIDController& drive);
+
+    // 转向电机读数为 offset 时模块朝正前方（度）
+    void setSteerOffsets(const std::array<float, 4>& offsetDeg);
+    void setDriveDirections(const std::array<float, 4>& directions);
+
+    bool update(const BodyTwist& command, float dt);
+    [[nodiscard]] BodyTwist odometry() const;
+
+    void reset();
+
+private:
+    static constexpr size_t MODULES = SwerveKinematics::MODULES;
+
+    MotorGroup& group_;
+    SwerveKinematics kinematics_;
+    std::array<PIDController, MODULES> steerAngle_;
+    std::array<PIDController, MODULES> steerSpeed_;
+    std::array<PIDController, MODULES> drive_;
+    std::array<float, MODULES> steerOffsets_;
+    std::array<float, MODULES> driveDirections_;
+    BodyTwist odometry_;
+};
+
+// 两轴云台：组成员顺序为 yaw、pitch。既可给视线方向，也可直接给关节角向量
+class GimbalController {
+public:
+    GimbalController(MotorGroup& group, const GimbalKinematics& kinematics,
+                     const PIDController& angle, const PIDController& speed);
+
+    // 关节角向量指令（度，yaw 为多圈角度）
+    bool updateJoints(float yawDeg, float pitchDeg, float dt);
+    // 视线方向指令，yaw 取离当前位置最近的一圈
+    bool updateDirection(float x, float y, float z, float dt);
+
+    void reset();
+
+private:
+    MotorGroup& group_;
+    GimbalKinematics kinematics_;
+    std::array<PIDController, 2> angle_;
+    std::array<PIDController, 2> speed_;
+};
+
+#endif // CHASSIS_CONTROLLER_H
@@ -0,0 +1,51 @@
+#ifndef DISTURBANCE_OBSERVER_H
+#define DISTURBANCE_OBSERVER_H
+
+#include "include/PlantIdentifier.h"
+
+// 扩张状态观测器（ESO）形式的扰动观测器。
+// 名义模型 J * dω/dt = τ - b * ω + d，d 为集总扰动力矩（负载、库仑摩擦、模型误差），按分段常值扩张为状态。
+// 离散化采用零阶保持的精确解，观测误差的两个极点都配置在 exp(-bandwidth * dt)，
+// 控制周期抖动时按实际 dt 重新计算增益，dt 不变时不重复计算。
+// 补偿量 -d 直接前馈叠加到力矩指令上，PID 只需处理名义模型
+class DisturbanceObserver {
+public:
+    struct Config {
+        PlantModel model;              // 使用 inertia / damping，其余项归入扰动
+        float bandwidth = 30.0f;       // 观测器带宽（rad/s），不宜超过 0.5 / dt
+        float maxCompensation = 1.0f;  // 补偿力矩限幅（Nm）
+    };
+
+    DisturbanceObserver();
+    explicit DisturbanceObserver(const Config& config);
+
+    void setConfig(const Config& config);
+    [[nodiscard]] const Config& config() const;
+    // 观测器状态从 omega、零扰动重新开始
+    void reset(float omega = 0.0f);
+
+    // 每个控制周期调用一次：torque 为上一周期实际下发（已限幅）的力矩，omega 为本周期测量值
+    void update(float torque, float omega, float dt);
+
+    [[nodiscard]] float disturbance() const;   // 扰动力矩估计（Nm）
+    [[nodiscard]] float omega() const;         // 滤波后的角速度（rad/s）
+    [[nodiscard]] float compensation() const;  // 应叠加到力矩指令上的补偿量（Nm，已限幅）
+    [[nodiscard]] bool initialized() const;
+
+private:
+    void computeGains(float dt);
+
+    Config config_;
+    float omega_;
+    float disturbance_;
+    bool initialized_;
+
+    // 离散模型 ω[k+1] = a * ω[k] + g * (τ + d) 与校正增益
+    float gainDt_;
+    float a_;
+    float g_;
+    float m1_;
+    float m2_;
+};
+
+#endif // DISTURBANCE_OBSERVER_H
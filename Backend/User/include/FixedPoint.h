@@ -0,0 +1,136 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// Q 格式定点数，所有运算饱和，舍入方式在编译期选定，
+// 与单片机上同样位宽、同样舍入的实现逐位一致
+enum class Rounding {
+    TRUNCATE,  // 算术右移（向负无穷截断），与 CMSIS-DSP 一致
+    NEAREST    // 四舍五入
+};
+
+namespace fixed_detail {
+
+template<typename T> struct Wider;
+template<> struct Wider<int8_t>  { using type = int16_t; };
+template<> struct Wider<int16_t> { using type = int32_t; };
+template<> struct Wider<int32_t> { using type = int64_t; };
+
+template<typename Storage, typename Wide>
+constexpr Storage saturate(Wide value) {
+    constexpr Wide lo = static_cast<Wide>(std::numeric_limits<Storage>::min());
+    constexpr Wide hi = static_cast<Wide>(std::numeric_limits<Storage>::max());
+    return static_cast<Storage>(value < lo ? lo : (value > hi ? hi : value));
+}
+
+} // namespace fixed_detail
+
+template<typename Storage, int FracBits, Rounding Round = Rounding::TRUNCATE>
+class Fixed {
+    static_assert(std::is_integral_v<Storage> && std::is_signed_v<Storage>, "Fixed 需要有符号整数存储");
+    static_assert(FracBits > 0 && FracBits < static_cast<int>(sizeof(Storage) * 8), "小数位数超出存储位宽");
+
+public:
+    using storage_type = Storage;
+    using wide_type = typename fixed_detail::Wider<Storage>::type;
+    static constexpr int FRAC_BITS = FracBits;
+    static constexpr wide_type ONE = wide_type{1} << FracBits;
+
+    constexpr Fixed() : raw_(0) {}
+    constexpr explicit Fixed(int value) : raw_(fixed_detail::saturate<Storage>(static_cast<wide_type>(value) * ONE)) {}
+    constexpr explicit Fixed(float value) : Fixed(static_cast<double>(value)) {}
+    constexpr explicit Fixed(double value) : raw_(fromDouble(value)) {}
+
+    static constexpr Fixed fromRaw(Storage raw) {
+        Fixed f;
+        f.raw_ = raw;
+        return f;
+    }
+
+    // 带检查的换算：NaN 或超出 Q 格式范围时返回 false，out 仍写入与构造函数相同的结果（NaN 为 0，越界为饱和值）
+    static constexpr bool tryFromDouble(double value, Fixed& out) {
+        out.raw_ = fromDouble(value);
+        return representable(value);
+    }
+
+    [[nodiscard]] static constexpr bool representable(double value) {
+        // NaN 的比较均为 false，两个条件同时成立才可表示
+        const double scaled = value * static_cast<double>(ONE);
+        return scaled > static_cast<double>(std::numeric_limits<Storage>::min()) - 0.5 &&
+               scaled < static_cast<double>(std::numeric_limits<Storage>::max()) + 0.5;
+    }
+
+    static constexpr Fixed min() { return fromRaw(std::numeric_limits<Storage>::min()); }
+    static constexpr Fixed max() { return fromRaw(std::numeric_limits<Storage>::max()); }
+    static constexpr Fixed epsilon() { return fromRaw(1); }
+
+    [[nodiscard]] constexpr Storage raw() const { return raw_; }
+    constexpr explicit operator float() const { return static_cast<float>(raw_) / static_cast<float>(ONE); }
+    constexpr explicit operator double() const { return static_cast<double>(raw_) / static_cast<double>(ONE); }
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b) {
+        return fromRaw(fixed_detail::saturate<Storage>(static_cast<wide_type>(a.raw_) + b.raw_));
+    }
+    friend constexpr Fixed operator-(Fixed a, Fixed b) {
+        return fromRaw(fixed_detail::saturate<Storage>(static_cast<wide_type>(a.raw_) - b.raw_));
+    }
+    friend constexpr Fixed operator*(Fixed a, Fixed b) {
+        wide_type product = static_cast<wide_type>(a.raw_) * b.raw_;
+        if constexpr (Round == Rounding::NEAREST) {
+            product += wide_type{1} << (FracBits - 1);
+        }
+        return fromRaw(fixed_detail::saturate<Storage>(product >> FracBits));
+    }
+    friend constexpr Fixed operator/(Fixed a, Fixed b) {
+        if (b.raw_ == 0) {
+            return a.raw_ >= 0 ? max() : min();
+        }
+        return fromRaw(fixed_detail::saturate<Storage>(static_cast<wide_type>(a.raw_) * ONE / b.raw_));
+    }
+    constexpr Fixed operator-() const {
+        return fromRaw(fixed_detail::saturate<Storage>(-static_cast<wide_type>(raw_)));
+    }
+
+    constexpr Fixed& operator+=(Fixed other) { return *this = *this + other; }
+    constexpr Fixed& operator-=(Fixed other) { return *this = *this - other; }
+    constexpr Fixed& operator*=(Fixed other) { return *this = *this * other; }
+    constexpr Fixed& operator/=(Fixed other) { return *this = *this / other; }
+
+    friend constexpr bool operator==(Fixed a, Fixed b) { return a.raw_ == b.raw_; }
+    friend constexpr bool operator!=(Fixed a, Fixed b) { return a.raw_ != b.raw_; }
+    friend constexpr bool operator<(Fixed a, Fixed b) { return a.raw_ < b.raw_; }
+    friend constexpr bool operator>(Fixed a, Fixed b) { return a.raw_ > b.raw_; }
+    friend constexpr bool operator<=(Fixed a, Fixed b) { return a.raw_ <= b.raw_; }
+    friend constexpr bool operator>=(Fixed a, Fixed b) { return a.raw_ >= b.raw_; }
+
+private:
+    static constexpr Storage fromDouble(double value) {
+        // NaN 与任何值比较都为 false，会落到越界转换（未定义行为），显式映射为 0
+        if (value != value) {
+            return 0;
+        }
+        const double scaled = value * static_cast<double>(ONE);
+        // 浮点 -> 定点统一四舍五入，避免参数换算引入偏差
+        const double rounded = scaled >= 0.0 ? scaled + 0.5 : scaled - 0.5;
+        if (rounded <= static_cast<double>(std::numeric_limits<Storage>::min())) {
+            return std::numeric_limits<Storage>::min();
+        }
+        if (rounded >= static_cast<double>(std::numeric_limits<Storage>::max())) {
+            return std::numeric_limits<Storage>::max();
+        }
+        return static_cast<Storage>(rounded);
+    }
+
+    Storage raw_;
+};
+
+// 常用 Q 格式
+using q15_t = Fixed<int16_t, 15>;      // [-1, 1)
+using q31_t = Fixed<int32_t, 31>;      // [-1, 1)
+using q7_8_t = Fixed<int16_t, 8>;      // [-128, 128)
+using q16_16_t = Fixed<int32_t, 16>;   // [-32768, 32768)
+
+#endif // FIXED_POINT_H
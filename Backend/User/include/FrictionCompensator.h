@@ -0,0 +1,66 @@
+#ifndef FRICTION_COMPENSATOR_H
+#define FRICTION_COMPENSATOR_H
+
+#include <cstddef>
+#include <string>
+
+// 查表式摩擦 / 齿槽力矩补偿，在线学习。
+// 摩擦表以角速度为自变量，节点按 sign(ω)·sqrt(|ω| / omegaMax) 均匀分布，零速附近更密，能表示 Stribeck 段的陡峭变化；
+// 齿槽表以圈内角度为自变量，周期插值，输出减去表的均值（常值部分归摩擦表）。
+// 学习采用归一化 LMS：学习目标为需要补偿的力矩（通常取扰动观测器估计的 -d），
+// 每次更新只修改两张表各两个相邻节点，单周期开销为常数
+class FrictionCompensator {
+public:
+    static constexpr size_t FRICTION_BINS = 33;
+    static constexpr size_t COGGING_BINS = 64;
+
+    struct Config {
+        float omegaMax = 30.0f;        // 摩擦表覆盖的角速度范围（rad/s），超出取端点
+        float learningRate = 0.02f;    // 归一化 LMS 步长（0..1），越小越平滑、收敛越慢
+        float omegaDeadband = 0.05f;   // |ω| 低于此值时处于静摩擦区，摩擦力矩不确定，不学习
+        float coggingMaxOmega = 5.0f;  // 齿槽表只在此速度以下学习，更快时观测器跟不上齿槽频率
+        float maxCompensation = 0.5f;  // 补偿力矩限幅（Nm）
+        bool learnCogging = true;
+    };
+
+    FrictionCompensator();
+    explicit FrictionCompensator(const Config& config);
+
+    void setConfig(const Config& config);
+    [[nodiscard]] const Config& config() const;
+    // 清空学习结果
+    void reset();
+
+    // 每个控制周期调用一次：omega 为测量角速度，angleDeg 为圈内角度（任意圈数均可），
+    // target 为本周期需要补偿的力矩（Nm）
+    void update(float omega, float angleDeg, float target);
+
+    // 前馈补偿力矩（Nm，已限幅）。omega 建议用参考速度：静止起步时测量速度为 0，按参考方向预先补偿静摩擦
+    [[nodiscard]] float compensation(float omega, float angleDeg) const;
+    [[nodiscard]] float friction(float omega) const;
+    [[nodiscard]] float cogging(float angleDeg) const;
+    [[nodiscard]] size_t updates() const;
+
+    // 保存 / 载入学习结果（CSV：table,index,value），表长不一致时载入失败
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+private:
+    // 插值位置：节点 index 与 index + 1，权重 1 - t 与 t
+    struct Lookup {
+        size_t index;
+        float t;
+    };
+
+    [[nodiscard]] Lookup frictionLookup(float omega) const;
+    [[nodiscard]] static Lookup coggingLookup(float angleDeg);
+    [[nodiscard]] float coggingAt(const Lookup& lookup) const;
+
+    Config config_;
+    float friction_[FRICTION_BINS];
+    float cogging_[COGGING_BINS];
+    float coggingSum_;
+    size_t updates_;
+};
+
+#endif // FRICTION_COMPENSATOR_H
@@ -0,0 +1,68 @@
+#ifndef MOTION_PROFILE_H
+#define MOTION_PROFILE_H
+
+#include <cstddef>
+#include <vector>
+
+// 运动约束，单位与位置一致（如 度、度/秒、度/秒²、度/秒³）
+struct MotionLimits {
+    float maxVelocity = 1.0f;
+    float maxAcceleration = 1.0f;
+    float maxJerk = 0.0f;         // <= 0 表示不限加加速度，即梯形速度曲线
+};
+
+// 某一时刻的参考量
+struct MotionSample {
+    double position = 0.0;
+    float velocity = 0.0f;
+    float acceleration = 0.0f;
+};
+
+// 运动轨迹：规划时解析求出至多 7 段恒定加加速度的分段（加加速 / 匀加速 / 减加速 / 匀速 / ...），
+// 控制周期内 sample 为 O(1) 且不分配内存。
+// maxJerk > 0 为 S 曲线（加速度连续），否则为梯形；两者在给定约束下都是最短时间轨迹，
+// 距离不足以达到最大速度 / 加速度时自动退化为三角形或无匀加速段的形状
+class MotionProfile {
+public:
+    MotionProfile();
+
+    // 静止到静止的点到点运动
+    bool planMove(double start, double goal, const MotionLimits& limits);
+    // 从 startVelocity 变速到 targetVelocity（限幅到 maxVelocity）后保持匀速，用于速度参考整形；
+    // 起始加速度视为 0
+    bool planVelocity(double start, float startVelocity, float targetVelocity, const MotionLimits& limits);
+    // 把已规划的轨迹在时间上拉伸到 duration（不得短于最短时长），速度、加速度、加加速度随之减小
+    bool stretch(float duration);
+
+    // 多轴同步：各轴已按最短时间规划，统一拉伸到最慢一轴的时长，同时出发同时到达；返回公共时长
+    static float synchronize(std::vector<MotionProfile>& profiles);
+
+    // t 从轨迹起点算起（秒）；结束后保持终点状态，速度轨迹则保持目标速度匀速前进
+    [[nodiscard]] MotionSample sample(float t) const;
+    [[nodiscard]] float duration() const;
+    [[nodiscard]] bool finished(float t) const;
+    [[nodiscard]] bool valid() const;
+
+private:
+    static constexpr size_t SEGMENTS = 7;
+
+    struct Segment {
+        float start;          // 起始时刻（拉伸前）
+        float jerk;
+        float acceleration;
+        float velocity;
+        double position;
+    };
+
+    void build(double start, float startVelocity, size_t count,
+               const double durations[], const double jerks[], const double accelerations[]);
+
+    Segment segments_[SEGMENTS];
+    size_t count_;
+    float duration_;      // 拉伸前的时长
+    float timeScale_;     // 拉伸倍数，>= 1
+    MotionSample end_;
+    bool valid_;
+};
+
+#endif // MOTION_PROFILE_H
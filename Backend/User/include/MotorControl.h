@@ -4,13 +4,80 @@
 #include <atomic>
 #include <thread>
 #include "include/PidController.h"
+#include "include/SignalGenerator.h"
+#include "include/AutoTuner.h"
+#include "include/DisturbanceObserver.h"
+#include "include/MpcController.h"
+#include "include/FrictionCompensator.h"
+#include "control_task.h"
+
+// 控制周期（秒）
+constexpr float CONTROL_DT = 0.01f;
+
+// 激励注入通道
+enum class ExcitationChannel {
+    SPEED_REF,  // 叠加到速度参考
+    TORQUE      // 直接叠加到输出力矩
+};
 
 // 全局控制标志
 extern std::atomic<bool> g_running;
 extern std::atomic<float> g_targetTorque;
 extern PIDController SpeedController;
+extern PIDController AngleController;
 extern float omega_watch;  // 用于监控角度反馈
 extern float omega_ref;    // 期望角速度
+extern float angle_ref;    // 期望角度（度），多圈模式下为展开后的目标位置
+extern float angle_mode;   // >0.5 时使用角度-速度串级控制
+extern float latency_comp; // >0.5 时角度环按反馈时延把角度外推到当前时刻
+extern float loop_dt_watch;  // 实际采样间隔（毫秒）
+extern float use_estimator;  // >0.5 时控制器使用卡尔曼滤波后的角度与角速度
+extern float accel_watch;    // 估计的角加速度（rad/s²）
+extern float multi_turn;     // >0.5 时角度环跟踪多圈位置，否则按最短路径转到 angle_ref
+extern float turns_watch;    // 当前圈数
+
+// 参考轨迹规划：>0.5 时角度 / 速度参考的变化经 S 曲线（profile_jerk 为 0 时为梯形）整形，
+// 轨迹速度、加速度经 SpeedController.setFeedForward(kv, ka) 设置的增益前馈
+extern float profile_mode;
+extern float profile_vel;    // 最大角速度（rad/s）
+extern float profile_acc;    // 最大角加速度（rad/s²）
+extern float profile_jerk;   // 最大加加速度（rad/s³）
+
+// 扰动观测器：由下发力矩与角速度估计负载等集总扰动力矩，dob_mode >0.5 时把补偿量前馈到力矩指令。
+// 名义模型可由辨识结果设置：Observer.setConfig({result.model, dob_bandwidth, 1.0f})
+extern DisturbanceObserver Observer;
+extern float dob_mode;
+extern float dob_bandwidth;      // 观测器带宽（rad/s）
+extern float disturbance_watch;  // 扰动力矩估计（Nm）
+
+// 模型预测控制：mpc_mode >0.5 时由 Mpc 直接计算力矩，取代角度环与速度环 PID；
+// 扰动观测器或摩擦补偿表的前馈量作为已知扰动参与预测
+extern MpcController Mpc;
+extern float mpc_mode;
+extern float mpc_iterations_watch;  // 本周期有效集迭代次数
+
+// 摩擦 / 齿槽补偿表：friction_learn >0.5 时以扰动观测器的估计在线学习，
+// friction_comp >0.5 时按参考速度与圈内角度查表前馈（dob_mode 开启时以观测器补偿为准）
+extern FrictionCompensator Friction;
+extern float friction_comp;
+extern float friction_learn;
+extern float friction_watch;  // 本周期前馈补偿力矩（Nm）
+
+// 自整定：调试界面中把 autotune_request 置 1 即开始继电反馈实验
+extern AutoTuner Tuner;
+extern float autotune_request;
+
+// 控制线程上的协程调度器，每个控制周期在控制器计算之前 tick 一次；
+// 动作序列写成 ControlTask 后 Scheduler.spawn 即可，不需要额外线程
+extern ControlScheduler Scheduler;
+extern float sequence_request;  // 调试界面置 1 时启动示例序列
+
+// 示例序列：多圈位置环转过 stepDeg，到位后保持再转回，最后做一次速度斜坡
+ControlTask positionSequence(float stepDeg);
+
+// 系统辨识激励
+extern SignalGenerator Excitation;
+extern ExcitationRecorder ExcitationLog;
 
 // 转矩控制线程函数
 void torqueUpdateLoop();
@@ -19,4 +86,9 @@ void torqueUpdateLoop();
 void startTorqueControl(std::thread& controlThread);
 void stopTorqueControl(std::thread& controlThread);
 
+// 配置并启动一次激励实验，激励与响应会同步记录到 ExcitationLog。
+// 配置在下一个控制周期开始时由控制线程应用（需已 startTorqueControl），时长无效时返回 false
+bool startExcitation(const SignalGenerator::Config& config, ExcitationChannel channel);
+void stopExcitation();
+
 #endif // MOTOR_CONTROL_H
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef MPC_CONTROLLER_H
+#define MPC_CONTROLLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "include/PlantIdentifier.h"
+
+// 线性 MPC 参数，位置单位 rad，速度 rad/s，力矩 Nm
+struct MpcConfig {
+    PlantModel model;              // 使用 inertia / damping 作为预测模型
+    size_t horizon = 10;           // 预测步数，1..MpcController::MAX_HORIZON
+    float dt = 0.01f;              // 预测步长（秒），通常等于控制周期
+    float positionWeight = 2000.0f;
+    float velocityWeight = 1.0f;
+    float torqueWeight = 1e-3f;    // 须与 slewWeight 之和为正，保证 QP 严格凸
+    float slewWeight = 1e-2f;      // 相邻步力矩变化的权重
+    float torqueMin = -1.8f;
+    float torqueMax = 1.8f;
+    int maxIterations = 64;        // 有效集迭代上限；提前结束时输出仍满足限幅且优于初值
+};
+
+// 基于 J * dω/dt = τ - b * ω + d 的线性 MPC：
+// 预测方程按零阶保持精确离散化后压缩为只含力矩序列的 QP，
+//   min ½ uᵀ H u + fᵀ u,  torqueMin <= u <= torqueMax
+// H 只在 setConfig 时计算，每个周期构造 f 后用原始有效集法求解：迭代中解始终可行，
+// 每次迭代在自由变量上做一次 Cholesky（N <= 32，微秒级）。
+// 上一周期的解与有效集平移一步作为热启动，饱和状态不变时通常一两次迭代即满足 KKT 条件。
+// 全部矩阵为定长数组，运行时不分配内存
+class MpcController {
+public:
+    static constexpr size_t MAX_HORIZON = 32;
+
+    struct Stats {
+        int iterations = 0;
+        int activeConstraints = 0;   // 解中处于限幅的步数
+        bool converged = false;      // 满足 KKT 条件
+    };
+
+    MpcController();
+    explicit MpcController(const MpcConfig& config);
+
+    // 参数非法（步数越界、惯量非正、限幅为空、QP 非严格凸）时返回 false 并保留原参数
+    bool setConfig(const MpcConfig& config);
+    [[nodiscard]] const MpcConfig& config() const;
+
+    // 丢弃热启动数据
+    void reset();
+
+    // 返回本周期力矩。positionRef / velocityRef 为第 1..horizon 步的参考，位置与 position 取同一原点；
+    // positionRef 为空时只跟踪速度（速度环），velocityRef 为空时速度参考取 0。
+    // disturbance 为已知扰动力矩（如扰动观测器估计值），按常值预测
+    float compute(float position, float omega, const float* positionRef, const float* velocityRef,
+                  float disturbance = 0.0f);
+
+    // 最近一次求解的完整力矩序列与统计
+    [[nodiscard]] const float* plan() const;
+    [[nodiscard]] const Stats& stats() const;
+
+private:
+    using Matrix = float[MAX_HORIZON][MAX_HORIZON];
+
+    enum Bound : int8_t {
+        FREE,
+        LOWER,
+        UPPER
+    };
+
+    static bool buildHessian(const MpcConfig& config, const Matrix& position, const Matrix& velocity,
+                             bool tracksPosition, Matrix& hessian);
+    void solve(const Matrix& hessian, const float* gradient);
+
+    MpcConfig config_;
+    size_t horizon_;
+
+    // 预测矩阵：第 k 步的位置 / 速度对力矩序列的响应（下三角）
+    Matrix positionResponse_;
+    Matrix velocityResponse_;
+    float decay_;              // a = exp(-b dt / J)
+    float velocityGain_;       // ω 对力矩的单步增益 g
+    float positionDecayGain_;  // 位置对 ω 的单步增益 c
+    float positionGain_;       // 位置对力矩的单步增益 h
+
+    // 跟踪位置 / 只跟踪速度两组权重对应的 Hessian
+    Matrix positionHessian_;
+    Matrix velocityHessian_;
+
+    float solution_[MAX_HORIZON];
+    Bound bounds_[MAX_HORIZON];
+    float lastTorque_;
+    bool warm_;
+    const Matrix* lastHessian_;
+    Stats stats_;
+};
+
+#endif // MPC_CONTROLLER_H
@@ -3,14 +3,30 @@
 
 class PIDController {
 public:
+    // 抗积分饱和方式
+    enum class AntiWindup {
+        CLAMP,             // 仅积分限幅（默认）
+        BACK_CALCULATION,  // 反算：按 kb * (饱和输出 - 未饱和输出) 回退积分
+        CONDITIONAL        // 条件积分：输出饱和且误差同向时停止积分
+    };
+
     PIDController(float kp, float ki, float kd, float outputMin, float outputMax,  float integral_max);
 
     // 设置PID参数
     void setGains(float kp, float ki, float kd);
     void setLimits(float outputMin, float outputMax);
 
+    // 扩展功能，默认值与原有行为一致
+    void setDerivativeFilter(float tau);            // 微分一阶滤波时间常数（秒），0 表示不滤波
+    void setSetpointWeights(float b, float c);      // 2-DOF 设定值权重：b 作用于比例项，c 作用于微分项（c = 0 即微分先行）
+    void setAntiWindup(AntiWindup mode, float kb = 0.0f);
+    void setFeedForward(float kv, float ka);        // 参考速度 / 参考加速度前馈
+    void setRateLimit(float maxRate);               // 输出变化率上限（单位/秒），<= 0 表示不限制
+
     // 计算PID输出
     float compute(float setpoint, float measurement, float dt);
+    // 带前馈的计算，velocityRef / accelRef 为参考轨迹的速度和加速度
+    float compute(float setpoint, float measurement, float dt, float velocityRef, float accelRef);
 
     // 重置控制器
     void reset();
@@ -25,6 +41,19 @@ public:
     float lastError_;
 
 private:
+    float derivativeTau_ = 0.0f;
+    float setpointWeightP_ = 1.0f;
+    float setpointWeightD_ = 1.0f;
+    AntiWindup antiWindup_ = AntiWindup::CLAMP;
+    float backCalcGain_ = 0.0f;
+    float kv_ = 0.0f;
+    float ka_ = 0.0f;
+    float maxRate_ = 0.0f;
+
+    float lastDerivativeInput_ = 0.0f;
+    float derivative_ = 0.0f;
+    float lastOutput_ = 0.0f;
+    bool primed_ = false;  // reset 后的第一次计算只记录微分输入，不产生微分冲击
 };
 
-#endif // PID_CONTROLLER_H
\ No newline at end of file
+#endif // PID_CONTROLLER_H
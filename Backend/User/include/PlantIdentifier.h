@@ -0,0 +1,92 @@
+#ifndef PLANT_IDENTIFIER_H
+#define PLANT_IDENTIFIER_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include "include/SignalGenerator.h"
+
+// 电机被控对象模型：J * dω/dt = τ(t - delay) - b * ω - c * sign(ω)
+// c 为库仑摩擦，运动状态下仿真中的 staticFriction 与 loadTorque 合并体现在这一项
+struct PlantModel {
+    float inertia = 0.01f;   // 转动惯量 J（kg·m²）
+    float damping = 0.002f;  // 粘性摩擦 b（Nm·s/rad）
+    float coulomb = 0.07f;   // 库仑摩擦 c（Nm）
+    float delay = 0.0f;      // 纯延时（秒）
+
+    // 前向欧拉仿真一步，返回新的角速度（离线整定用）
+    [[nodiscard]] float step(float omega, float torque, float dt) const;
+};
+
+// 辨识结果，区间为 95% 置信区间的半宽
+struct IdentificationResult {
+    bool valid = false;
+    PlantModel model;
+    float inertiaCi = 0.0f;
+    float dampingCi = 0.0f;
+    float coulombCi = 0.0f;
+    int delaySamples = 0;
+    float residualStd = 0.0f;  // 加速度残差标准差（rad/s²）
+    float r2 = 0.0f;           // 拟合优度
+    size_t samplesUsed = 0;
+};
+
+// 批量最小二乘辨识：
+// 回归 dω/dt = [τ(k-d), -ω, -sign(ω)] · [1/J, b/J, c/J]，对每个候选延时只累加一次 3x3 法方程，
+// 复杂度 O(N * maxDelay)，数万样本在毫秒级完成
+class PlantIdentifier {
+public:
+    struct Options {
+        int maxDelaySamples = 10;    // 延时搜索范围（采样数）
+        float omegaDeadband = 0.05f; // |ω| 低于此值视为静摩擦区，不参与回归
+        bool omegaFromAngle = false; // 使用角度（度）差分代替角速度测量
+    };
+
+    PlantIdentifier() = default;
+    explicit PlantIdentifier(const Options& options);
+
+    void setOptions(const Options& options);
+
+    // torque: 下发力矩；omega: 角速度（rad/s）；angle: 角度（度，可为空）
+    [[nodiscard]] IdentificationResult identify(const float* torque, const float* omega, const float* angle,
+                                                size_t count, float dt) const;
+
+    // 直接使用激励实验记录的数据
+    [[nodiscard]] IdentificationResult identify(const std::vector<ExcitationRecorder::Sample>& samples,
+                                                float dt) const;
+
+private:
+    Options options_;
+};
+
+// 递推最小二乘辨识（带遗忘因子），控制周期内在线更新，无内存分配
+class RecursivePlantIdentifier {
+public:
+    static constexpr int MAX_DELAY = 64;
+
+    explicit RecursivePlantIdentifier(float forgetting = 0.999f, int delaySamples = 0,
+                                      float omegaDeadband = 0.05f);
+
+    void reset(const PlantModel& initial = PlantModel{});
+
+    // 每个控制周期调用一次
+    void update(float torque, float omega, float dt);
+
+    [[nodiscard]] PlantModel model() const;
+    [[nodiscard]] size_t updates() const;
+
+private:
+    std::array<float, 3> theta_{};
+    std::array<std::array<float, 3>, 3> P_{};
+    std::array<float, MAX_DELAY + 1> torqueHistory_{};
+    int historyIndex_ = 0;
+    int delaySamples_;
+    float forgetting_;
+    float omegaDeadband_;
+    float lastOmega_ = 0.0f;
+    float lastDt_ = 0.0f;
+    bool hasLast_ = false;
+    size_t updates_ = 0;
+};
+
+#endif // PLANT_IDENTIFIER_H
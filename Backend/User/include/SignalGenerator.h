@@ -0,0 +1,102 @@
+#ifndef SIGNAL_GENERATOR_H
+#define SIGNAL_GENERATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// 激励信号发生器：用于系统辨识，信号在 configure 时预计算成表，
+// 控制周期内只做一次查表，保证采样级别的时间精度
+class SignalGenerator {
+public:
+    enum class Type {
+        STEP,      // 阶跃
+        RAMP,      // 斜坡
+        SINE,      // 正弦
+        CHIRP,     // 对数扫频
+        PRBS,      // 伪随机二进制序列
+        MULTISINE  // 多正弦（Schroeder 相位）
+    };
+
+    struct Config {
+        Type type = Type::STEP;
+        float amplitude = 1.0f;     // 幅值
+        float offset = 0.0f;        // 直流偏置
+        float duration = 5.0f;      // 持续时间（秒）
+        float delay = 0.0f;         // 起始延时（秒，STEP/RAMP 有效）
+        float freqStart = 0.1f;     // 起始频率（Hz，SINE 只用此项）
+        float freqEnd = 10.0f;      // 终止频率（Hz）
+        int prbsOrder = 9;          // PRBS 阶数（2~16）
+        int prbsHold = 1;           // PRBS 每一位保持的采样数
+        int multisineCount = 10;    // 多正弦分量数
+        bool loop = false;          // 播放结束后是否循环
+    };
+
+    SignalGenerator() = default;
+
+    // 按控制周期 dt 预计算信号表，运行中调用会失败
+    bool configure(const Config& config, float dt);
+
+    // 播放控制
+    void start();
+    void stop();
+    [[nodiscard]] bool isActive() const;
+
+    // 取出下一个采样点（每个控制周期调用一次），未激活时返回 0
+    float next();
+
+    [[nodiscard]] float valueAt(size_t index) const;
+    [[nodiscard]] size_t length() const;
+    [[nodiscard]] size_t position() const;
+    [[nodiscard]] float sampleTime() const;
+    [[nodiscard]] const Config& config() const;
+    [[nodiscard]] const std::vector<float>& table() const;
+
+private:
+    void fillStep();
+    void fillRamp();
+    void fillSine();
+    void fillChirp();
+    void fillPrbs();
+    void fillMultisine();
+
+    Config config_;
+    float dt_ = 0.0f;
+    std::vector<float> table_;
+    size_t index_ = 0;
+    std::atomic<bool> active_{false};
+};
+
+// 激励 / 响应记录器：容量在 reserve 时一次性分配，控制周期内不再分配内存
+class ExcitationRecorder {
+public:
+    struct Sample {
+        float time;        // 反馈采样时刻（秒，相对实验首个采样）
+        float excitation;  // 注入的激励量
+        float reference;   // 速度参考
+        float torque;      // 实际下发力矩（Nm）
+        float angle;       // 角度（度）
+        float omega;       // 角速度（rad/s）
+    };
+
+    // 清空并设置记录上限，上限以内不再分配内存
+    void reserve(size_t capacity);
+    void clear();
+
+    // 达到 reserve 设定的上限后丢弃新样本，返回是否写入成功
+    bool record(const Sample& sample);
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] bool full() const;
+    [[nodiscard]] const std::vector<Sample>& samples() const;
+
+    // 导出为 CSV，便于离线做频响分析
+    bool saveCsv(const std::string& path) const;
+
+private:
+    std::vector<Sample> samples_;
+    size_t limit_ = 0;  // vector 的 capacity 不会缩小，不能作为上限
+};
+
+#endif // SIGNAL_GENERATOR_H
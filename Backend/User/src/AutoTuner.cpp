@@ -0,0 +1,176 @@
+#include "include/AutoTuner.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+constexpr float DEG_PER_RAD = 180.0f / PI;
+
+// 角度环：被控对象为 速度参考(rad/s) -> 角度(度) 的积分环节，增益 180/π，
+// 速度闭环近似为有效延时 thetaEff，按 SIMC 积分对象规则（τc = θ）整定
+void tuneAngleLoop(float thetaEff, AutoTuner::Result& result) {
+    const float kc = 1.0f / (DEG_PER_RAD * 2.0f * thetaEff);
+    const float ti = 4.0f * 2.0f * thetaEff;
+    result.angleKp = kc;
+    result.angleKi = kc / ti;
+}
+
+} // namespace
+
+AutoTuner::Result AutoTuner::tuneFromModel(const PlantModel& model, float dt, float tauC) {
+    Result result;
+    if (model.inertia <= 0.0f || dt <= 0.0f) {
+        return result;
+    }
+
+    // 零阶保持器贡献半个采样周期的延时
+    const float theta = std::max(model.delay, 0.0f) + 0.5f * dt;
+    const float tc = tauC > 0.0f ? tauC : std::max(theta, dt);
+
+    // 一阶对象 K/(Ts+1)：K = 1/b, T = J/b，于是 Kc = T/(K(τc+θ)) = J/(τc+θ)
+    const float kc = model.inertia / (tc + theta);
+    const float T = model.damping > 0.0f ? model.inertia / model.damping : INFINITY;
+    const float ti = std::min(T, 4.0f * (tc + theta));
+
+    result.speedKp = kc;
+    result.speedKi = kc / ti;
+    tuneAngleLoop(tc + theta, result);
+    result.valid = std::isfinite(result.speedKp) && std::isfinite(result.speedKi);
+    return result;
+}
+
+bool AutoTuner::startRelay(const RelayConfig& config) {
+    return startRelay(config, Limits{});
+}
+
+bool AutoTuner::startRelay(const RelayConfig& config, const Limits& limits) {
+    if (state_ == State::RUNNING || config.cycles <= 0 || config.amplitude <= 0.0f) {
+        return false;
+    }
+
+    relay_ = config;
+    limits_ = limits;
+    relay_.amplitude = std::min(relay_.amplitude, limits_.maxTorque);
+    result_ = Result{};
+
+    elapsed_ = 0.0f;
+    travel_ = 0.0f;
+    hasAngle_ = false;
+    output_ = relay_.amplitude;
+    lastSwitchTime_ = -1.0f;
+    cycleMax_ = -INFINITY;
+    cycleMin_ = INFINITY;
+    switches_ = 0;
+    measuredCycles_ = 0;
+    periodSum_ = 0.0f;
+    amplitudeSum_ = 0.0f;
+
+    state_ = State::RUNNING;
+    return true;
+}
+
+void AutoTuner::abort() {
+    if (state_ == State::RUNNING) {
+        state_ = State::ABORTED;
+    }
+}
+
+float AutoTuner::update(float omega, float angleDeg, float dt) {
+    if (state_ != State::RUNNING) {
+        return 0.0f;
+    }
+
+    elapsed_ += dt;
+
+    // 累计转角（处理 ±360° 回绕）
+    if (hasAngle_) {
+        float delta = angleDeg - lastAngle_;
+        delta -= 360.0f * std::round(delta / 360.0f);
+        travel_ += delta;
+    }
+    lastAngle_ = angleDeg;
+    hasAngle_ = true;
+
+    // 安全限制：超行程 / 超速 / 超时立即终止并输出零力矩
+    if (std::abs(travel_) > limits_.maxTravel || std::abs(omega) > limits_.maxOmega ||
+        elapsed_ > limits_.timeout) {
+        state_ = State::ABORTED;
+        return 0.0f;
+    }
+
+    cycleMax_ = std::max(cycleMax_, omega);
+    cycleMin_ = std::min(cycleMin_, omega);
+
+    // 带滞环的继电器
+    const float error = relay_.setpoint - omega;
+    if (output_ > 0.0f && error < -relay_.hysteresis) {
+        output_ = -relay_.amplitude;
+    } else if (output_ < 0.0f && error > relay_.hysteresis) {
+        output_ = relay_.amplitude;
+
+        // 以上升沿为周期边界，第一个周期为过渡过程不计入
+        if (lastSwitchTime_ >= 0.0f && ++switches_ > 1) {
+            periodSum_ += elapsed_ - lastSwitchTime_;
+            amplitudeSum_ += 0.5f * (cycleMax_ - cycleMin_);
+            if (++measuredCycles_ >= relay_.cycles) {
+                finish();
+                return 0.0f;
+            }
+        }
+        lastSwitchTime_ = elapsed_;
+        cycleMax_ = omega;
+        cycleMin_ = omega;
+    }
+
+    return std::clamp(output_, -limits_.maxTorque, limits_.maxTorque);
+}
+
+void AutoTuner::finish() {
+    const float period = periodSum_ / static_cast<float>(measuredCycles_);
+    const float amplitude = amplitudeSum_ / static_cast<float>(measuredCycles_);
+    const float eps = relay_.hysteresis;
+
+    // 描述函数：Ku = 4h / (π·sqrt(a² - ε²))
+    const float effective = std::sqrt(std::max(amplitude * amplitude - eps * eps, 1e-12f));
+    const float ku = 4.0f * relay_.amplitude / (PI * effective);
+
+    result_.ultimateGain = ku;
+    result_.ultimatePeriod = period;
+
+    // Tyreus-Luyben PI 规则，比 Ziegler-Nichols 更保守，超调更小
+    result_.speedKp = ku / 3.2f;
+    result_.speedKi = result_.speedKp / (2.2f * period);
+
+    // 速度闭环时间常数近似为 Pu/2
+    tuneAngleLoop(0.5f * period, result_);
+
+    result_.valid = std::isfinite(ku) && period > 0.0f;
+    state_ = result_.valid ? State::DONE : State::ABORTED;
+}
+
+AutoTuner::State AutoTuner::state() const {
+    return state_;
+}
+
+bool AutoTuner::isRunning() const {
+    return state_ == State::RUNNING;
+}
+
+const AutoTuner::Result& AutoTuner::result() const {
+    return result_;
+}
+
+bool AutoTuner::apply(const Result& result, PIDController& speedController, PIDController* angleController) {
+    if (!result.valid) {
+        return false;
+    }
+
+    speedController.setGains(result.speedKp, result.speedKi, speedController.kd_);
+    speedController.reset();
+    if (angleController) {
+        angleController->setGains(result.angleKp, result.angleKi, angleController->kd_);
+        angleController->reset();
+    }
+    return true;
+}
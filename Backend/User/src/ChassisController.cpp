@@ -0,0 +1,166 @@
+#include "include/ChassisController.h"
+#include <algorithm>
+#include <cmath>
+#include "motor.h"
+
+namespace {
+
+constexpr float DEG_PER_RAD = 57.2957795f;
+
+} // namespace
+
+MecanumController::MecanumController(MotorGroup& group, const MecanumKinematics& kinematics, const PIDController& wheel) :
+    group_(group),
+    kinematics_(kinematics),
+    wheels_{wheel, wheel, wheel, wheel},
+    directions_{1.0f, 1.0f, 1.0f, 1.0f},
+    odometry_{} {
+}
+
+void MecanumController::setDirections(const std::array<float, 4>& directions) {
+    directions_ = directions;
+}
+
+bool MecanumController::update(const BodyTwist& command, float dt) {
+    if (group_.size() != 4) {
+        return false;
+    }
+
+    MotorGroup::Joints joints;
+    group_.readJoints(joints);
+    float measured[4];
+    for (size_t i = 0; i < 4; ++i) {
+        measured[i] = joints.omega[i] * directions_[i];
+    }
+    odometry_ = kinematics_.forward(measured);
+
+    float target[4];
+    kinematics_.inverse(command, target);
+    float torques[4];
+    for (size_t i = 0; i < 4; ++i) {
+        torques[i] = wheels_[i].compute(target[i], measured[i], dt) * directions_[i];
+    }
+    group_.publish(torques);
+    return true;
+}
+
+BodyTwist MecanumController::odometry() const {
+    return odometry_;
+}
+
+void MecanumController::reset() {
+    for (PIDController& pid : wheels_) {
+        pid.reset();
+    }
+    odometry_ = {};
+}
+
+SwerveController::SwerveController(MotorGroup& group, const SwerveKinematics& kinematics,
+                                   const PIDController& steerAngle, const PIDController& steerSpeed,
+                                   const PIDController& drive) :
+    group_(group),
+    kinematics_(kinematics),
+    steerAngle_{steerAngle, steerAngle, steerAngle, steerAngle},
+    steerSpeed_{steerSpeed, steerSpeed, steerSpeed, steerSpeed},
+    drive_{drive, drive, drive, drive},
+    steerOffsets_{},
+    driveDirections_{1.0f, 1.0f, 1.0f, 1.0f},
+    odometry_{} {
+}
+
+void SwerveController::setSteerOffsets(const std::array<float, 4>& offsetDeg) {
+    steerOffsets_ = offsetDeg;
+}
+
+void SwerveController::setDriveDirections(const std::array<float, 4>& directions) {
+    driveDirections_ = directions;
+}
+
+bool SwerveController::update(const BodyTwist& command, float dt) {
+    if (group_.size() != 2 * MODULES) {
+        return false;
+    }
+
+    MotorGroup::Joints joints;
+    group_.readJoints(joints);
+    // 转向角保持多圈展开，逆解给出的目标朝向紧邻当前值，角度环不会绕远路
+    float steer[MODULES];
+    ModuleState measured[MODULES];
+    for (size_t i = 0; i < MODULES; ++i) {
+        steer[i] = static_cast<float>(joints.position[i] - steerOffsets_[i]) / DEG_PER_RAD;
+        measured[i] = {steer[i], joints.omega[MODULES + i] * driveDirections_[i]};
+    }
+    odometry_ = kinematics_.forward(measured);
+
+    ModuleState target[MODULES];
+    kinematics_.inverse(command, steer, target);
+    float torques[2 * MODULES];
+    for (size_t i = 0; i < MODULES; ++i) {
+        const float error = target[i].steer - steer[i];
+        const float omegaRef = steerAngle_[i].compute(target[i].steer * DEG_PER_RAD, steer[i] * DEG_PER_RAD, dt);
+        torques[i] = steerSpeed_[i].compute(omegaRef, joints.omega[i], dt);
+        const float speedRef = target[i].speed * std::max(0.0f, std::cos(error));
+        torques[MODULES + i] = drive_[i].compute(speedRef, measured[i].speed, dt) * driveDirections_[i];
+    }
+    group_.publish(torques);
+    return true;
+}
+
+BodyTwist SwerveController::odometry() const {
+    return odometry_;
+}
+
+void SwerveController::reset() {
+    for (size_t i = 0; i < MODULES; ++i) {
+        steerAngle_[i].reset();
+        steerSpeed_[i].reset();
+        drive_[i].reset();
+    }
+    odometry_ = {};
+}
+
+GimbalController::GimbalController(MotorGroup& group, const GimbalKinematics& kinematics,
+                                   const PIDController& angle, const PIDController& speed) :
+    group_(group),
+    kinematics_(kinematics),
+    angle_{angle, angle},
+    speed_{speed, speed} {
+}
+
+bool GimbalController::updateJoints(float yawDeg, float pitchDeg, float dt) {
+    if (group_.size() != 2) {
+        return false;
+    }
+
+    MotorGroup::Joints joints;
+    group_.readJoints(joints);
+    const float targets[2] = {yawDeg, pitchDeg};
+    float torques[2];
+    for (size_t i = 0; i < 2; ++i) {
+        const float position = static_cast<float>(joints.position[i]);
+        const float omegaRef = angle_[i].compute(targets[i], position, dt);
+        torques[i] = speed_[i].compute(omegaRef, joints.omega[i], dt);
+    }
+    group_.publish(torques);
+    return true;
+}
+
+bool GimbalController::updateDirection(float x, float y, float z, float dt) {
+    if (group_.size() != 2) {
+        return false;
+    }
+
+    const Motor* yawMotor = group_.member(0);
+    const float currentYaw = yawMotor ? static_cast<float>(yawMotor->getPosition()) / DEG_PER_RAD : 0.0f;
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+    kinematics_.inverse(x, y, z, currentYaw, yaw, pitch);
+    return updateJoints(yaw * DEG_PER_RAD, pitch * DEG_PER_RAD, dt);
+}
+
+void GimbalController::reset() {
+    for (size_t i = 0; i < 2; ++i) {
+        angle_[i].reset();
+        speed_[i].reset();
+    }
+}
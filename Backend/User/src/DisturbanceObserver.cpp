@@ -0,0 +1,87 @@
+#include "include/DisturbanceObserver.h"
+#include <algorithm>
+#include <cmath>
+
+DisturbanceObserver::DisturbanceObserver() :
+    DisturbanceObserver(Config{}) {
+}
+
+DisturbanceObserver::DisturbanceObserver(const Config& config) :
+    config_(config),
+    omega_(0.0f),
+    disturbance_(0.0f),
+    initialized_(false),
+    gainDt_(0.0f),
+    a_(1.0f),
+    g_(0.0f),
+    m1_(0.0f),
+    m2_(0.0f) {
+}
+
+void DisturbanceObserver::setConfig(const Config& config) {
+    config_ = config;
+    gainDt_ = 0.0f;
+}
+
+const DisturbanceObserver::Config& DisturbanceObserver::config() const {
+    return config_;
+}
+
+void DisturbanceObserver::reset(float omega) {
+    omega_ = omega;
+    disturbance_ = 0.0f;
+    initialized_ = false;
+}
+
+void DisturbanceObserver::computeGains(float dt) {
+    const float inertia = std::max(config_.model.inertia, 1e-6f);
+    const float damping = std::max(config_.model.damping, 0.0f);
+    // 零阶保持：a = exp(-b dt / J)，g = (1 - a) / b；b -> 0 时 g -> dt / J
+    const float x = damping * dt / inertia;
+    a_ = std::exp(-x);
+    g_ = x > 1e-6f ? (1.0f - a_) / damping : dt / inertia;
+
+    // 校正后误差的转移阵为 (I - M C) A，令其特征多项式为 (λ - p)²：
+    // det = (1 - m1) a = p²，trace = (1 - m1) a + 1 - m2 g = 2p
+    const float p = std::exp(-config_.bandwidth * dt);
+    m1_ = 1.0f - p * p / a_;
+    m2_ = (1.0f - p) * (1.0f - p) / g_;
+    gainDt_ = dt;
+}
+
+void DisturbanceObserver::update(float torque, float omega, float dt) {
+    if (!initialized_) {
+        omega_ = omega;
+        initialized_ = true;
+        return;
+    }
+    if (dt <= 0.0f) {
+        return;
+    }
+    if (dt != gainDt_) {
+        computeGains(dt);
+    }
+
+    // 预测：上一周期的力矩与扰动作用 dt
+    const float predicted = a_ * omega_ + g_ * (torque + disturbance_);
+    // 校正
+    const float error = omega - predicted;
+    omega_ = predicted + m1_ * error;
+    disturbance_ += m2_ * error;
+}
+
+float DisturbanceObserver::disturbance() const {
+    return disturbance_;
+}
+
+float DisturbanceObserver::omega() const {
+    return omega_;
+}
+
+float DisturbanceObserver::compensation() const {
+    return std::clamp(-disturbance_, -config_.maxCompensation, config_.maxCompensation);
+}
+
+bool DisturbanceObserver::initialized() const {
+    return initialized_;
+}
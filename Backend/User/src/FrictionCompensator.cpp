@@ -0,0 +1,167 @@
+#include "include/FrictionCompensator.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+FrictionCompensator::FrictionCompensator() :
+    FrictionCompensator(Config{}) {
+}
+
+FrictionCompensator::FrictionCompensator(const Config& config) :
+    config_(config),
+    friction_{},
+    cogging_{},
+    coggingSum_(0.0f),
+    updates_(0) {
+}
+
+void FrictionCompensator::setConfig(const Config& config) {
+    config_ = config;
+}
+
+const FrictionCompensator::Config& FrictionCompensator::config() const {
+    return config_;
+}
+
+void FrictionCompensator::reset() {
+    std::fill(friction_, friction_ + FRICTION_BINS, 0.0f);
+    std::fill(cogging_, cogging_ + COGGING_BINS, 0.0f);
+    coggingSum_ = 0.0f;
+    updates_ = 0;
+}
+
+FrictionCompensator::Lookup FrictionCompensator::frictionLookup(float omega) const {
+    // 节点坐标 u ∈ [-1, 1]，ω = sign(u) u² omegaMax
+    const float ratio = std::min(std::abs(omega) / std::max(config_.omegaMax, 1e-6f), 1.0f);
+    const float u = std::copysign(std::sqrt(ratio), omega);
+    const float position = (u + 1.0f) * 0.5f * static_cast<float>(FRICTION_BINS - 1);
+    const size_t index = std::min(static_cast<size_t>(position), FRICTION_BINS - 2);
+    return {index, position - static_cast<float>(index)};
+}
+
+FrictionCompensator::Lookup FrictionCompensator::coggingLookup(float angleDeg) {
+    const float wrapped = angleDeg - 360.0f * std::floor(angleDeg / 360.0f);
+    const float position = wrapped / 360.0f * static_cast<float>(COGGING_BINS);
+    const size_t index = std::min(static_cast<size_t>(position), COGGING_BINS - 1);
+    return {index, position - static_cast<float>(index)};
+}
+
+float FrictionCompensator::coggingAt(const Lookup& lookup) const {
+    const size_t next = (lookup.index + 1) % COGGING_BINS;
+    return (1.0f - lookup.t) * cogging_[lookup.index] + lookup.t * cogging_[next]
+         - coggingSum_ / static_cast<float>(COGGING_BINS);
+}
+
+void FrictionCompensator::update(float omega, float angleDeg, float target) {
+    const float speed = std::abs(omega);
+    if (speed < config_.omegaDeadband || !std::isfinite(target)) {
+        return;
+    }
+
+    const Lookup f = frictionLookup(omega);
+    const bool learnCogging = config_.learnCogging && speed < config_.coggingMaxOmega;
+    const Lookup c = coggingLookup(angleDeg);
+
+    float predicted = (1.0f - f.t) * friction_[f.index] + f.t * friction_[f.index + 1];
+    float norm = (1.0f - f.t) * (1.0f - f.t) + f.t * f.t;
+    if (learnCogging) {
+        predicted += coggingAt(c);
+        norm += (1.0f - c.t) * (1.0f - c.t) + c.t * c.t;
+    }
+
+    // 归一化 LMS：沿插值权重方向修正，步长与节点权重的平方和无关
+    const float step = config_.learningRate * (target - predicted) / norm;
+    friction_[f.index] += step * (1.0f - f.t);
+    friction_[f.index + 1] += step * f.t;
+    if (learnCogging) {
+        const size_t next = (c.index + 1) % COGGING_BINS;
+        cogging_[c.index] += step * (1.0f - c.t);
+        cogging_[next] += step * c.t;
+        coggingSum_ += step;
+    }
+    ++updates_;
+}
+
+float FrictionCompensator::friction(float omega) const {
+    const Lookup f = frictionLookup(omega);
+    return (1.0f - f.t) * friction_[f.index] + f.t * friction_[f.index + 1];
+}
+
+float FrictionCompensator::cogging(float angleDeg) const {
+    return coggingAt(coggingLookup(angleDeg));
+}
+
+float FrictionCompensator::compensation(float omega, float angleDeg) const {
+    return std::clamp(friction(omega) + cogging(angleDeg), -config_.maxCompensation, config_.maxCompensation);
+}
+
+size_t FrictionCompensator::updates() const {
+    return updates_;
+}
+
+bool FrictionCompensator::save(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "FrictionCompensator: cannot write " << path << std::endl;
+        return false;
+    }
+
+    file << "table,index,value\n";
+    for (size_t i = 0; i < FRICTION_BINS; ++i) {
+        file << "friction," << i << ',' << friction_[i] << '\n';
+    }
+    for (size_t i = 0; i < COGGING_BINS; ++i) {
+        file << "cogging," << i << ',' << cogging_[i] << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+bool FrictionCompensator::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "FrictionCompensator: cannot read " << path << std::endl;
+        return false;
+    }
+
+    float friction[FRICTION_BINS] = {};
+    float cogging[COGGING_BINS] = {};
+    size_t frictionCount = 0;
+    size_t coggingCount = 0;
+    std::string line;
+    std::getline(file, line);  // 表头
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string table, index, value;
+        if (!std::getline(fields, table, ',') || !std::getline(fields, index, ',') || !std::getline(fields, value)) {
+            continue;
+        }
+        try {
+            const size_t i = std::stoul(index);
+            if (table == "friction" && i < FRICTION_BINS) {
+                friction[i] = std::stof(value);
+                ++frictionCount;
+            } else if (table == "cogging" && i < COGGING_BINS) {
+                cogging[i] = std::stof(value);
+                ++coggingCount;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "FrictionCompensator: malformed line '" << line << "' in " << path << std::endl;
+            return false;
+        }
+    }
+    if (frictionCount != FRICTION_BINS || coggingCount != COGGING_BINS) {
+        std::cerr << "FrictionCompensator: table size mismatch in " << path << std::endl;
+        return false;
+    }
+
+    std::copy(friction, friction + FRICTION_BINS, friction_);
+    std::copy(cogging, cogging + COGGING_BINS, cogging_);
+    coggingSum_ = 0.0f;
+    for (float value : cogging_) {
+        coggingSum_ += value;
+    }
+    return true;
+}
@@ -0,0 +1,186 @@
+#include "include/MotionProfile.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 一个加速（或减速）阶段的形状：两段加加速度为 ±J、持续 jerkTime 的过渡段，中间匀加速 constTime
+struct Ramp {
+    double jerkTime;
+    double constTime;
+    double peakAcceleration;
+};
+
+// 速度变化 dv（> 0）所需的最短加速阶段
+Ramp rampFor(double dv, double a, double j) {
+    if (j <= 0.0) {
+        return {0.0, dv / a, a};
+    }
+    if (dv * j >= a * a) {
+        return {a / j, dv / a - a / j, a};
+    }
+    const double tj = std::sqrt(dv / j);
+    return {tj, 0.0, j * tj};
+}
+
+// 静止到静止走过距离 d（> 0）能达到的峰值速度
+double peakVelocity(double d, double v, double a, double j) {
+    if (j <= 0.0) {
+        return std::min(v, std::sqrt(d * a));
+    }
+    // 加速阶段的距离为 v * 加速时长 / 2，加减速合计 v * 加速时长
+    const Ramp full = rampFor(v, a, j);
+    if (v * (2.0 * full.jerkTime + full.constTime) <= d) {
+        return v;
+    }
+    // 有匀加速段：d = v² / a + v * a / j
+    const double withConst = 0.5 * a * (-a / j + std::sqrt(a * a / (j * j) + 4.0 * d / a));
+    if (withConst * j >= a * a) {
+        return withConst;
+    }
+    // 只有加加速段：d = 2 * v * sqrt(v / j)
+    return std::pow(0.5 * d * std::sqrt(j), 2.0 / 3.0);
+}
+
+} // namespace
+
+MotionProfile::MotionProfile() :
+    segments_{},
+    count_(0),
+    duration_(0.0f),
+    timeScale_(1.0f),
+    valid_(false) {
+}
+
+bool MotionProfile::planMove(double start, double goal, const MotionLimits& limits) {
+    if (limits.maxVelocity <= 0.0f || limits.maxAcceleration <= 0.0f) {
+        valid_ = false;
+        return false;
+    }
+
+    const double distance = std::abs(goal - start);
+    const double sign = goal >= start ? 1.0 : -1.0;
+    const double j = limits.maxJerk;
+    const double v = peakVelocity(distance, limits.maxVelocity, limits.maxAcceleration, j);
+    const Ramp ramp = v > 0.0 ? rampFor(v, limits.maxAcceleration, j) : Ramp{0.0, 0.0, 0.0};
+    const double rampTime = 2.0 * ramp.jerkTime + ramp.constTime;
+    const double cruise = v > 0.0 ? std::max(0.0, (distance - v * rampTime) / v) : 0.0;
+    const double jerk = j > 0.0 ? sign * j : 0.0;
+    const double ap = sign * ramp.peakAcceleration;
+
+    const double durations[SEGMENTS] = {ramp.jerkTime, ramp.constTime, ramp.jerkTime, cruise,
+                                        ramp.jerkTime, ramp.constTime, ramp.jerkTime};
+    const double jerks[SEGMENTS] = {jerk, 0.0, -jerk, 0.0, -jerk, 0.0, jerk};
+    // 梯形轨迹的过渡段时长为 0，各段起始加速度直接给出
+    const double accelerations[SEGMENTS] = {0.0, ap, ap, 0.0, 0.0, -ap, -ap};
+    build(start, 0.0f, SEGMENTS, durations, jerks, accelerations);
+    // 消除积分舍入，终点精确等于目标
+    end_.position = goal;
+    return true;
+}
+
+bool MotionProfile::planVelocity(double start, float startVelocity, float targetVelocity, const MotionLimits& limits) {
+    if (limits.maxVelocity <= 0.0f || limits.maxAcceleration <= 0.0f) {
+        valid_ = false;
+        return false;
+    }
+
+    const float target = std::clamp(targetVelocity, -limits.maxVelocity, limits.maxVelocity);
+    const double dv = static_cast<double>(target) - startVelocity;
+    const double sign = dv >= 0.0 ? 1.0 : -1.0;
+    const double j = limits.maxJerk;
+    const Ramp ramp = dv != 0.0 ? rampFor(std::abs(dv), limits.maxAcceleration, j) : Ramp{0.0, 0.0, 0.0};
+    const double jerk = j > 0.0 ? sign * j : 0.0;
+    const double ap = sign * ramp.peakAcceleration;
+
+    const double durations[3] = {ramp.jerkTime, ramp.constTime, ramp.jerkTime};
+    const double jerks[3] = {jerk, 0.0, -jerk};
+    const double accelerations[3] = {0.0, ap, ap};
+    build(start, startVelocity, 3, durations, jerks, accelerations);
+    end_.velocity = target;
+    return true;
+}
+
+void MotionProfile::build(double start, float startVelocity, size_t count,
+                          const double durations[], const double jerks[], const double accelerations[]) {
+    double t = 0.0;
+    double p = start;
+    double v = startVelocity;
+    for (size_t i = 0; i < count; ++i) {
+        const double a = accelerations[i];
+        const double j = jerks[i];
+        const double dt = durations[i];
+        segments_[i] = {static_cast<float>(t), static_cast<float>(j), static_cast<float>(a), static_cast<float>(v), p};
+        p += v * dt + a * dt * dt / 2.0 + j * dt * dt * dt / 6.0;
+        v += a * dt + j * dt * dt / 2.0;
+        t += dt;
+    }
+
+    count_ = count;
+    duration_ = static_cast<float>(t);
+    timeScale_ = 1.0f;
+    end_ = {p, static_cast<float>(v), 0.0f};
+    valid_ = true;
+}
+
+bool MotionProfile::stretch(float duration) {
+    if (!valid_ || duration_ <= 0.0f || duration < duration_) {
+        return false;
+    }
+    timeScale_ = duration / duration_;
+    return true;
+}
+
+float MotionProfile::synchronize(std::vector<MotionProfile>& profiles) {
+    float longest = 0.0f;
+    for (const MotionProfile& profile : profiles) {
+        if (profile.valid_) {
+            longest = std::max(longest, profile.duration_);
+        }
+    }
+    for (MotionProfile& profile : profiles) {
+        profile.stretch(longest);
+    }
+    return longest;
+}
+
+MotionSample MotionProfile::sample(float t) const {
+    if (!valid_) {
+        return {};
+    }
+
+    // 拉伸 k 倍：p(t) = p0(t / k)，速度除以 k，加速度除以 k²
+    const float tau = std::max(0.0f, t / timeScale_);
+    const float inverse = 1.0f / timeScale_;
+    if (tau >= duration_) {
+        MotionSample result = end_;
+        result.position += static_cast<double>(end_.velocity) * (tau - duration_);
+        result.velocity *= inverse;
+        return result;
+    }
+
+    // 时长为 0 的段与下一段起点相同，从后往前找到的总是有效段
+    size_t index = count_ - 1;
+    while (index > 0 && segments_[index].start > tau) {
+        --index;
+    }
+    const Segment& s = segments_[index];
+    const float dt = tau - s.start;
+    MotionSample result;
+    result.position = s.position + dt * (s.velocity + dt * (s.acceleration / 2.0f + dt * s.jerk / 6.0f));
+    result.velocity = (s.velocity + dt * (s.acceleration + dt * s.jerk / 2.0f)) * inverse;
+    result.acceleration = (s.acceleration + dt * s.jerk) * inverse * inverse;
+    return result;
+}
+
+float MotionProfile::duration() const {
+    return duration_ * timeScale_;
+}
+
+bool MotionProfile::finished(float t) const {
+    return !valid_ || t >= duration();
+}
+
+bool MotionProfile::valid() const {
+    return valid_;
+}
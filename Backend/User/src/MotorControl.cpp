@@ -1,9 +1,15 @@
 #include "include/MotorControl.h"
+#include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <iostream>
+#include <mutex>
 #include "motor_manager.h"
+#include "angle_tracker.h"
+#include "profiler.h"
 
 #include "include/PidController.h"
+#include "include/MotionProfile.h"
 
 // 全局变量定义
 std::atomic<bool> g_running{false};
@@ -11,29 +17,308 @@ std::atomic<float> g_targetTorque{0.0f};
 
 float omega_watch = 0.0f;  // 用于监控角度反馈
 float omega_ref = 0.0f;
+float angle_ref = 0.0f;
+float angle_mode = 0.0f;
+float latency_comp = 1.0f;
+float loop_dt_watch = 0.0f;
+float use_estimator = 0.0f;
+float accel_watch = 0.0f;
+float multi_turn = 0.0f;
+float turns_watch = 0.0f;
+float profile_mode = 0.0f;
+float profile_vel = 20.0f;
+float profile_acc = 100.0f;
+float profile_jerk = 2000.0f;
+float dob_mode = 0.0f;
+float dob_bandwidth = 30.0f;
+float disturbance_watch = 0.0f;
+float mpc_mode = 0.0f;
+float friction_comp = 0.0f;
+float friction_learn = 0.0f;
+float friction_watch = 0.0f;
+float mpc_iterations_watch = 0.0f;
+
+namespace {
+
+constexpr float DEG_PER_RAD = 57.2957795f;
+
+// 控制器使用的采样间隔上下限，超出说明反馈中断或时间戳异常
+constexpr float MIN_DT = 0.2f * CONTROL_DT;
+constexpr float MAX_DT = 5.0f * CONTROL_DT;
+
+// 轨迹整形后的参考（单位：度）。目标改变时从当前参考状态规划新轨迹，
+// 运动中再次修改目标在当前轨迹结束后生效，参考始终连续
+struct ShapedReference {
+    MotionProfile profile;
+    int64_t startNs = 0;
+    bool angleMode = false;
+    float target = 0.0f;
+
+    MotionSample update(bool angle, bool multiTurn, float newTarget, double position, float omegaDeg,
+                        int64_t nowNs, const MotionLimits& limits) {
+        const float elapsed = static_cast<float>(nowNs - startNs) * 1e-9f;
+        const bool restart = !profile.valid() || angle != angleMode;
+        if (restart || (newTarget != target && profile.finished(elapsed))) {
+            const MotionSample from = restart ? MotionSample{position, omegaDeg, 0.0f} : profile.sample(elapsed);
+            if (angle) {
+                const double goal = multiTurn ? newTarget : angle::nearestTarget(newTarget, from.position);
+                profile.planMove(from.position, goal, limits);
+            } else {
+                profile.planVelocity(from.position, from.velocity, newTarget, limits);
+            }
+            startNs = nowNs;
+            angleMode = angle;
+            target = newTarget;
+            return profile.sample(0.0f);
+        }
+        return profile.sample(elapsed);
+    }
+};
+
+} // namespace
 
 PIDController SpeedController(0.23f, 0.01f, 0.0f, -1.8f, 1.8f, 0.5f);
+PIDController AngleController(0.1f, 0.0f, 0.0f, -30.0f, 30.0f, 5.0f);
+
+AutoTuner Tuner;
+float autotune_request = 0.0f;
+
+ControlScheduler Scheduler;
+float sequence_request = 0.0f;
+
+DisturbanceObserver Observer;
+MpcController Mpc;
+FrictionCompensator Friction;
+
+SignalGenerator Excitation;
+ExcitationRecorder ExcitationLog;
+static std::atomic<ExcitationChannel> excitationChannel{ExcitationChannel::SPEED_REF};
+
+// 激励实验请求：startExcitation 只在调用方线程登记配置，信号表与记录缓冲区由控制线程在周期开始时重建，
+// next() / record() 使用中的内存不会被其他线程重新分配
+static std::mutex excitationRequestMutex;
+static SignalGenerator::Config pendingExcitation;
+static ExcitationChannel pendingChannel = ExcitationChannel::SPEED_REF;
+static std::atomic<bool> excitationPending{false};
+
+static void applyExcitationRequest() {
+    if (!excitationPending.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    SignalGenerator::Config config;
+    ExcitationChannel channel;
+    {
+        std::lock_guard<std::mutex> lock(excitationRequestMutex);
+        config = pendingExcitation;
+        channel = pendingChannel;
+    }
+
+    Excitation.stop();
+    if (!Excitation.configure(config, CONTROL_DT)) {
+        std::cerr << "Excitation: invalid configuration" << std::endl;
+        return;
+    }
+    ExcitationLog.reserve(Excitation.length());
+    excitationChannel.store(channel, std::memory_order_relaxed);
+    Excitation.start();
+}
 
 void torqueUpdateLoop() {
     using clock = std::chrono::high_resolution_clock;
     using duration = std::chrono::duration<double, std::milli>;
 
-    const duration target_duration(10.0);  // 10ms周期
+    const duration target_duration(CONTROL_DT * 1000.0);  // 10ms周期
     auto next_time = clock::now();
-    double time = 0.0;
+    int64_t excitationStartNs = 0;
+    MotorState lastState;
+    ShapedReference shaped;
+    bool predictive = false;
+    bool angleEngaged = false;
+    profiler::setThreadName("control");
 
     while (g_running) {
-        // 更新电机转矩
+        applyExcitationRequest();
+
+        // 先推进协程任务，任务修改的参考值在本周期生效
+        if (sequence_request > 0.5f) {
+            sequence_request = 0.0f;
+            Scheduler.spawn(positionSequence(90.0f));
+        }
+        {
+            PROFILE_ZONE("tasks");
+            Scheduler.tick(Motor::steadyNowNs());
+        }
+
+        // 更新电机转矩：只在有新反馈时运行控制器，没有新反馈的周期保持上一次的力矩输出，
+        // 积分、微分与扰动观测器不会在同一帧旧样本上重复推进
         auto& motorManager = MotorManager::getInstance();
-        if (Motor* motor = motorManager.getMotor(0)) {
-            omega_watch = motor->getCurrentOmega();
-            float torque = SpeedController.compute(
-                omega_ref,
-                motor->getCurrentOmega(),
-                0.01f  // dt = 10ms
-            );
-            motor->setTorque(torque);
-            time += 0.01;
+        Motor* motor = motorManager.getMotor(0);
+        const MotorState state = motor ? motor->getState() : lastState;
+        if (motor && state.sequence != lastState.sequence) {
+            PROFILE_ZONE("control");
+            float omega = state.omega;
+            double position = state.position;
+
+            // 用相邻两次所用反馈的采样时刻之差作为 dt，控制周期抖动或反馈丢帧时积分、微分仍然准确
+            float dt = CONTROL_DT;
+            if (lastState.sequence != 0) {
+                dt = std::clamp(static_cast<float>(state.sampleTimeNs - lastState.sampleTimeNs) * 1e-9f, MIN_DT, MAX_DT);
+            }
+            lastState = state;
+            loop_dt_watch = dt * 1000.0f;
+
+            if (use_estimator > 0.5f) {
+                // 使用滤波后的角度与角速度；时延补偿由估计器按常加速度模型外推到此刻
+                const EstimatedState estimate = latency_comp > 0.5f
+                    ? motor->predict(Motor::steadyNowNs(), MAX_DT)
+                    : motor->getEstimate();
+                if (estimate.timeNs != 0) {
+                    omega = estimate.omega;
+                    position = estimate.angle;
+                    accel_watch = estimate.acceleration;
+                }
+            } else if (latency_comp > 0.5f && state.sequence != 0) {
+                // 时延补偿：反馈从采样到此刻已经过去 age 秒，按当前角速度外推
+                const float age = static_cast<float>(Motor::steadyNowNs() - state.sampleTimeNs) * 1e-9f;
+                position += omega * DEG_PER_RAD * std::clamp(age, 0.0f, MAX_DT);
+            }
+            const float angle = angle::wrap180(position);
+            omega_watch = omega;
+            turns_watch = static_cast<float>(state.turns);
+
+            // 扰动观测器始终运行（开启补偿时已收敛）；输入为安全层之后实际下发的力矩与原始角速度反馈。
+            // 链路未就绪或急停锁存时下发力矩与电机实际受力对不上，观测器复位，不学习摩擦表
+            if (dob_bandwidth != Observer.config().bandwidth) {
+                DisturbanceObserver::Config config = Observer.config();
+                config.bandwidth = dob_bandwidth;
+                Observer.setConfig(config);
+            }
+            const bool driven = motor->getLinkState() == LinkState::UP && !SafetyGuard::isEmergencyStopped();
+            if (driven) {
+                Observer.update(motor->getAppliedTorque(), state.omega, dt);
+            } else {
+                Observer.reset(state.omega);
+            }
+            disturbance_watch = Observer.disturbance();
+
+            // 摩擦 / 齿槽表以观测器估计的扰动为学习目标
+            const float angleInTurn = angle::wrap360(position);
+            if (friction_learn > 0.5f && driven && Observer.initialized()) {
+                Friction.update(state.omega, angleInTurn, -Observer.disturbance());
+            }
+
+            // 一键自整定：实验期间由整定器接管力矩输出，结束后在本周期内写回参数
+            if (autotune_request > 0.5f) {
+                autotune_request = 0.0f;
+                Tuner.startRelay(AutoTuner::RelayConfig{});
+            }
+            if (Tuner.isRunning()) {
+                motor->setTorque(Tuner.update(omega, angle, dt));
+                if (Tuner.state() == AutoTuner::State::DONE) {
+                    AutoTuner::apply(Tuner.result(), SpeedController, &AngleController);
+                }
+            } else {
+                // 角度环输出作为速度参考：单圈模式误差取最短路径，多圈模式以展开位置为目标
+                float speedRef = omega_ref;
+                float velocityRef = 0.0f;
+                float accelRef = 0.0f;
+                float angleError = 0.0f;
+                const bool angleLoop = angle_mode > 0.5f;
+                const bool profiled = profile_mode > 0.5f;
+                const int64_t nowNs = Motor::steadyNowNs();
+                // 角度环以展开位置为测量值、测量值加误差为设定值：误差仍按上面的规则计算，
+                // 微分先行（c = 0）时微分项作用于位置本身，kd 才有效
+                const float measured = static_cast<float>(position);
+                if (angleLoop && !angleEngaged) {
+                    AngleController.reset();
+                }
+                angleEngaged = angleLoop;
+                if (!profiled && shaped.profile.valid()) {
+                    shaped = ShapedReference{};
+                }
+                if (profiled) {
+                    // 参考经轨迹规划，轨迹速度 / 加速度作为前馈（度 -> rad）
+                    const MotionLimits limits{profile_vel * DEG_PER_RAD, profile_acc * DEG_PER_RAD,
+                                              profile_jerk * DEG_PER_RAD};
+                    const MotionSample planned = shaped.update(angleLoop, multi_turn > 0.5f,
+                                                               angleLoop ? angle_ref : omega_ref * DEG_PER_RAD,
+                                                               position, omega * DEG_PER_RAD, nowNs, limits);
+                    velocityRef = planned.velocity / DEG_PER_RAD;
+                    accelRef = planned.acceleration / DEG_PER_RAD;
+                    speedRef = velocityRef;
+                    if (angleLoop) {
+                        angleError = static_cast<float>(planned.position - position);
+                        speedRef += AngleController.compute(measured + angleError, measured, dt);
+                    }
+                } else if (angleLoop) {
+                    angleError = multi_turn > 0.5f
+                        ? static_cast<float>(angle_ref - position)
+                        : angle::shortestDelta(position, angle_ref);
+                    speedRef = AngleController.compute(measured + angleError, measured, dt);
+                }
+
+                // 激励信号按控制周期逐点播放
+                const bool exciting = Excitation.isActive();
+                const float excitation = Excitation.next();
+                const ExcitationChannel channel = excitationChannel.load(std::memory_order_relaxed);
+                const float reference = speedRef + (channel == ExcitationChannel::SPEED_REF ? excitation : 0.0f);
+
+                // 力矩前馈：扰动观测器的估计已包含摩擦与齿槽，开启时优先；否则按参考速度查学习到的补偿表
+                float compensation = 0.0f;
+                if (dob_mode > 0.5f) {
+                    compensation = Observer.compensation();
+                } else if (friction_comp > 0.5f) {
+                    compensation = Friction.compensation(reference, angleInTurn);
+                }
+                friction_watch = compensation;
+
+                float torque = 0.0f;
+                if (mpc_mode > 0.5f) {
+                    if (!predictive) {
+                        Mpc.reset();
+                        predictive = true;
+                    }
+                    // MPC 直接输出力矩：位置参考为相对当前位置的偏差（rad），轨迹规划开启时按预测步长采样未来的参考
+                    float positionRefs[MpcController::MAX_HORIZON];
+                    float velocityRefs[MpcController::MAX_HORIZON];
+                    const MpcConfig& config = Mpc.config();
+                    const float elapsed = static_cast<float>(nowNs - shaped.startNs) * 1e-9f;
+                    for (size_t k = 0; k < config.horizon; ++k) {
+                        if (profiled) {
+                            const MotionSample ahead = shaped.profile.sample(elapsed + static_cast<float>(k + 1) * config.dt);
+                            positionRefs[k] = static_cast<float>(ahead.position - position) / DEG_PER_RAD;
+                            velocityRefs[k] = ahead.velocity / DEG_PER_RAD + (reference - speedRef);
+                        } else {
+                            positionRefs[k] = angleError / DEG_PER_RAD;
+                            velocityRefs[k] = angleLoop ? 0.0f : reference;
+                        }
+                    }
+                    // 前馈量作为已知扰动参与预测
+                    torque = Mpc.compute(0.0f, omega, angleLoop ? positionRefs : nullptr, velocityRefs, -compensation);
+                    mpc_iterations_watch = static_cast<float>(Mpc.stats().iterations);
+                } else {
+                    predictive = false;
+                    torque = profiled
+                        ? SpeedController.compute(reference, omega, dt, velocityRef, accelRef)
+                        : SpeedController.compute(reference, omega, dt);
+                    if (compensation != 0.0f) {
+                        torque = std::clamp(torque + compensation, SpeedController.outputMin_, SpeedController.outputMax_);
+                    }
+                }
+                if (channel == ExcitationChannel::TORQUE) {
+                    torque = std::clamp(torque + excitation, SpeedController.outputMin_, SpeedController.outputMax_);
+                }
+                motor->setTorque(torque);
+
+                // 激励只在新反馈到达时推进，时间轴取反馈采样时刻（相对实验首个采样），不受控制周期抖动与跳过的周期影响
+                if (exciting) {
+                    if (ExcitationLog.size() == 0) {
+                        excitationStartNs = state.sampleTimeNs;
+                    }
+                    const float sampleTime = static_cast<float>(state.sampleTimeNs - excitationStartNs) * 1e-9f;
+                    ExcitationLog.record({sampleTime, excitation, reference, torque, angle, omega});
+                }
+            }
         }
 
         next_time += std::chrono::duration_cast<clock::duration>(target_duration);
@@ -41,8 +326,59 @@ void torqueUpdateLoop() {
     }
 }
 
+ControlTask positionSequence(float stepDeg) {
+    using namespace std::chrono_literals;
+
+    Motor* motor = MotorManager::getInstance().getMotor(0);
+    if (!motor) {
+        co_return;
+    }
+    auto settled = [motor] {
+        return std::abs(angle_ref - motor->getPosition()) < 0.5 && std::abs(motor->getCurrentOmega()) < 0.05f;
+    };
+
+    const float savedMode = angle_mode;
+    const float savedMultiTurn = multi_turn;
+    const float start = static_cast<float>(motor->getPosition());
+    angle_mode = 1.0f;
+    multi_turn = 1.0f;
+
+    angle_ref = start + stepDeg;
+    if (!co_await control::until(settled, 3s)) {
+        std::cerr << "Sequence: target " << angle_ref << " not reached" << std::endl;
+    }
+    co_await control::sleep(500ms);
+
+    angle_ref = start;
+    co_await control::until(settled, 3s);
+
+    // 速度斜坡：1 秒升到 5 rad/s，保持 1 秒后降回 0
+    angle_mode = 0.0f;
+    constexpr int RAMP_TICKS = static_cast<int>(1.0f / CONTROL_DT);
+    for (int i = 0; i <= RAMP_TICKS; ++i) {
+        omega_ref = 5.0f * static_cast<float>(i) / RAMP_TICKS;
+        co_await control::nextTick();
+    }
+    co_await control::sleep(1s);
+    for (int i = RAMP_TICKS; i >= 0; --i) {
+        omega_ref = 5.0f * static_cast<float>(i) / RAMP_TICKS;
+        co_await control::nextTick();
+    }
+
+    angle_ref = static_cast<float>(motor->getPosition());
+    angle_mode = savedMode;
+    multi_turn = savedMultiTurn;
+}
+
 void startTorqueControl(std::thread& controlThread) {
     if (!g_running) {
+        // 微分先行并滤波，避免设定值阶跃引起微分冲击；条件积分防止饱和时积分累积
+        for (PIDController* controller : {&SpeedController, &AngleController}) {
+            controller->setSetpointWeights(1.0f, 0.0f);
+            controller->setDerivativeFilter(2.0f * CONTROL_DT);
+            controller->setAntiWindup(PIDController::AntiWindup::CONDITIONAL);
+        }
+
         g_running = true;
         controlThread = std::thread(torqueUpdateLoop);
     }
@@ -53,4 +389,21 @@ void stopTorqueControl(std::thread& controlThread) {
     if (controlThread.joinable()) {
         controlThread.join();
     }
-}
\ No newline at end of file
+}
+bool startExcitation(const SignalGenerator::Config& config, ExcitationChannel channel) {
+    if (config.duration <= 0.0f) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(excitationRequestMutex);
+        pendingExcitation = config;
+        pendingChannel = channel;
+    }
+    excitationPending.store(true, std::memory_order_release);
+    return true;
+}
+
+void stopExcitation() {
+    excitationPending.store(false, std::memory_order_release);
+    Excitation.stop();
+}
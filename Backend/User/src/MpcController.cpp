@@ -0,0 +1,311 @@
+#include "include/MpcController.h"
+#include <algorithm>
+#include <cmath>
+
+MpcController::MpcController() :
+    MpcController(MpcConfig{}) {
+}
+
+MpcController::MpcController(const MpcConfig& config) :
+    config_{},
+    horizon_(0),
+    positionResponse_{},
+    velocityResponse_{},
+    decay_(1.0f),
+    velocityGain_(0.0f),
+    positionDecayGain_(0.0f),
+    positionGain_(0.0f),
+    positionHessian_{},
+    velocityHessian_{},
+    solution_{},
+    bounds_{},
+    lastTorque_(0.0f),
+    warm_(false),
+    lastHessian_(nullptr),
+    stats_{} {
+    setConfig(config);
+}
+
+bool MpcController::setConfig(const MpcConfig& config) {
+    if (config.horizon == 0 || config.horizon > MAX_HORIZON || config.dt <= 0.0f ||
+        config.model.inertia <= 0.0f || config.model.damping < 0.0f || config.torqueMin > config.torqueMax) {
+        return false;
+    }
+
+    // 零阶保持离散化：ω' = a ω + g τ，θ' = θ + c ω + h τ；b -> 0 时取级数展开避免相消
+    const double inertia = config.model.inertia;
+    const double damping = config.model.damping;
+    const double dt = config.dt;
+    const double x = damping * dt / inertia;
+    const double a = std::exp(-x);
+    double g, c, h;
+    if (x < 1e-4) {
+        g = dt / inertia * (1.0 - x / 2.0);
+        c = dt * (1.0 - x / 2.0);
+        h = dt * dt / (2.0 * inertia) * (1.0 - x / 3.0);
+    } else {
+        g = -std::expm1(-x) / damping;
+        c = -std::expm1(-x) * inertia / damping;
+        h = (dt - c) / damping;
+    }
+
+    // 响应矩阵：velocity[k][j] = a^(k-j) g，position[k] = position[k-1] + c velocity[k-1] + h e_k
+    const size_t n = config.horizon;
+    Matrix position{};
+    Matrix velocity{};
+    for (size_t k = 0; k < n; ++k) {
+        for (size_t j = 0; j <= k; ++j) {
+            velocity[k][j] = static_cast<float>(std::pow(a, static_cast<double>(k - j)) * g);
+        }
+        for (size_t j = 0; j < k; ++j) {
+            position[k][j] = static_cast<float>(position[k - 1][j] + c * velocity[k - 1][j]);
+        }
+        position[k][k] = static_cast<float>(h);
+    }
+
+    // 非严格凸（权重为 0 等）时保留原参数
+    Matrix positionHessian;
+    Matrix velocityHessian;
+    if (!buildHessian(config, position, velocity, true, positionHessian) ||
+        !buildHessian(config, position, velocity, false, velocityHessian)) {
+        return false;
+    }
+
+    config_ = config;
+    horizon_ = n;
+    std::copy(&position[0][0], &position[0][0] + MAX_HORIZON * MAX_HORIZON, &positionResponse_[0][0]);
+    std::copy(&velocity[0][0], &velocity[0][0] + MAX_HORIZON * MAX_HORIZON, &velocityResponse_[0][0]);
+    std::copy(&positionHessian[0][0], &positionHessian[0][0] + MAX_HORIZON * MAX_HORIZON, &positionHessian_[0][0]);
+    std::copy(&velocityHessian[0][0], &velocityHessian[0][0] + MAX_HORIZON * MAX_HORIZON, &velocityHessian_[0][0]);
+    decay_ = static_cast<float>(a);
+    velocityGain_ = static_cast<float>(g);
+    positionDecayGain_ = static_cast<float>(c);
+    positionGain_ = static_cast<float>(h);
+    reset();
+    return true;
+}
+
+const MpcConfig& MpcController::config() const {
+    return config_;
+}
+
+void MpcController::reset() {
+    warm_ = false;
+    lastHessian_ = nullptr;
+    lastTorque_ = 0.0f;
+    stats_ = {};
+}
+
+bool MpcController::buildHessian(const MpcConfig& config, const Matrix& position, const Matrix& velocity,
+                                 bool tracksPosition, Matrix& hessian) {
+    const size_t n = config.horizon;
+    const double qp = tracksPosition ? config.positionWeight : 0.0;
+    const double qv = config.velocityWeight;
+    if (qp < 0.0 || qv < 0.0 || config.torqueWeight < 0.0f || config.slewWeight < 0.0f ||
+        config.torqueWeight + config.slewWeight <= 0.0f) {
+        return false;
+    }
+
+    // H = qp PᵀP + qv VᵀV + r I + s D，D 为力矩差分的三对角阵（首步与上一周期力矩相减）。
+    // r + s > 0 时 H 正定
+    for (size_t i = 0; i < MAX_HORIZON; ++i) {
+        for (size_t j = 0; j < MAX_HORIZON; ++j) {
+            hessian[i][j] = 0.0f;
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j <= i; ++j) {
+            double sum = 0.0;
+            for (size_t k = i; k < n; ++k) {
+                sum += qp * position[k][i] * position[k][j] + qv * velocity[k][i] * velocity[k][j];
+            }
+            if (i == j) {
+                sum += config.torqueWeight + config.slewWeight * (i + 1 < n ? 2.0 : 1.0);
+            } else if (i == j + 1) {
+                sum -= config.slewWeight;
+            }
+            hessian[i][j] = static_cast<float>(sum);
+            hessian[j][i] = static_cast<float>(sum);
+        }
+    }
+    return true;
+}
+
+float MpcController::compute(float position, float omega, const float* positionRef, const float* velocityRef,
+                             float disturbance) {
+    const size_t n = horizon_;
+    if (n == 0) {
+        return std::clamp(0.0f, config_.torqueMin, config_.torqueMax);
+    }
+    const bool tracksPosition = positionRef != nullptr;
+    const Matrix& hessian = tracksPosition ? positionHessian_ : velocityHessian_;
+    const float qp = tracksPosition ? config_.positionWeight : 0.0f;
+    const float qv = config_.velocityWeight;
+
+    // 零输入（仅扰动）下的自由响应与参考之差
+    float positionError[MAX_HORIZON];
+    float velocityError[MAX_HORIZON];
+    float p = position;
+    float v = omega;
+    for (size_t k = 0; k < n; ++k) {
+        p += positionDecayGain_ * v + positionGain_ * disturbance;
+        v = decay_ * v + velocityGain_ * disturbance;
+        positionError[k] = tracksPosition ? qp * (p - positionRef[k]) : 0.0f;
+        velocityError[k] = qv * (v - (velocityRef ? velocityRef[k] : 0.0f));
+    }
+
+    // f = qp Pᵀ(自由位置 - 参考) + qv Vᵀ(自由速度 - 参考) - s u₋₁ e₀
+    float gradient[MAX_HORIZON];
+    for (size_t j = 0; j < n; ++j) {
+        float sum = 0.0f;
+        for (size_t k = j; k < n; ++k) {
+            sum += positionResponse_[k][j] * positionError[k] + velocityResponse_[k][j] * velocityError[k];
+        }
+        gradient[j] = sum;
+    }
+    gradient[0] -= config_.slewWeight * lastTorque_;
+
+    // 热启动：上一周期的解与有效集平移一步，末步沿用；切换权重组后从全部自由、零力矩开始
+    if (warm_ && lastHessian_ == &hessian) {
+        for (size_t k = 0; k + 1 < n; ++k) {
+            solution_[k] = solution_[k + 1];
+            bounds_[k] = bounds_[k + 1];
+        }
+    } else {
+        std::fill(solution_, solution_ + n, std::clamp(0.0f, config_.torqueMin, config_.torqueMax));
+        std::fill(bounds_, bounds_ + n, FREE);
+    }
+    lastHessian_ = &hessian;
+
+    solve(hessian, gradient);
+    warm_ = true;
+    lastTorque_ = solution_[0];
+    return solution_[0];
+}
+
+void MpcController::solve(const Matrix& hessian, const float* gradient) {
+    // 原始有效集法：bounds_ 为工作集（固定在上 / 下限的步），其余为自由变量。
+    // 每次迭代在工作集固定的条件下求自由变量的无约束最优解：
+    //   可行则移动过去，再检查工作集上的乘子，符号不对的放开一个；
+    //   不可行则沿该方向走到第一个触碰的限幅，把它加入工作集
+    constexpr double MULTIPLIER_TOLERANCE = 1e-6;
+    const size_t n = horizon_;
+    const double lower = config_.torqueMin;
+    const double upper = config_.torqueMax;
+
+    double x[MAX_HORIZON];
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = bounds_[i] == LOWER ? lower : (bounds_[i] == UPPER ? upper : std::clamp<double>(solution_[i], lower, upper));
+    }
+
+    stats_ = {};
+    for (int iteration = 1; iteration <= config_.maxIterations; ++iteration) {
+        stats_.iterations = iteration;
+
+        size_t free[MAX_HORIZON];
+        size_t m = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (bounds_[i] == FREE) {
+                free[m++] = i;
+            }
+        }
+
+        if (m > 0) {
+            // H_FF y = -(f_F + H_FW x_W)，逐行 Cholesky 后前代、回代
+            double factor[MAX_HORIZON][MAX_HORIZON];
+            double y[MAX_HORIZON];
+            for (size_t a = 0; a < m; ++a) {
+                const size_t i = free[a];
+                double rhs = -gradient[i];
+                for (size_t j = 0; j < n; ++j) {
+                    if (bounds_[j] != FREE) {
+                        rhs -= hessian[i][j] * x[j];
+                    }
+                }
+                for (size_t b = 0; b < a; ++b) {
+                    double sum = hessian[i][free[b]];
+                    for (size_t k = 0; k < b; ++k) {
+                        sum -= factor[a][k] * factor[b][k];
+                    }
+                    factor[a][b] = sum / factor[b][b];
+                    rhs -= factor[a][b] * y[b];
+                }
+                double diagonal = hessian[i][i];
+                for (size_t k = 0; k < a; ++k) {
+                    diagonal -= factor[a][k] * factor[a][k];
+                }
+                factor[a][a] = std::sqrt(std::max(diagonal, 1e-12));
+                y[a] = rhs / factor[a][a];
+            }
+            for (size_t a = m; a-- > 0;) {
+                double sum = y[a];
+                for (size_t b = a + 1; b < m; ++b) {
+                    sum -= factor[b][a] * y[b];
+                }
+                y[a] = sum / factor[a][a];
+            }
+
+            // 从当前可行点朝 y 前进，遇到限幅即停
+            double step = 1.0;
+            size_t blocking = n;
+            Bound blockingBound = FREE;
+            for (size_t a = 0; a < m; ++a) {
+                const size_t i = free[a];
+                const double delta = y[a] - x[i];
+                if (y[a] > upper && delta > 0.0 && (upper - x[i]) / delta < step) {
+                    step = (upper - x[i]) / delta;
+                    blocking = i;
+                    blockingBound = UPPER;
+                } else if (y[a] < lower && delta < 0.0 && (lower - x[i]) / delta < step) {
+                    step = (lower - x[i]) / delta;
+                    blocking = i;
+                    blockingBound = LOWER;
+                }
+            }
+            for (size_t a = 0; a < m; ++a) {
+                x[free[a]] += step * (y[a] - x[free[a]]);
+            }
+            if (blocking < n) {
+                x[blocking] = blockingBound == UPPER ? upper : lower;
+                bounds_[blocking] = blockingBound;
+                continue;
+            }
+        }
+
+        // 工作集上的乘子 λ = (H x + f)_i：下限处须 >= 0，上限处须 <= 0，放开违反最多的一个
+        size_t release = n;
+        double worst = MULTIPLIER_TOLERANCE;
+        for (size_t i = 0; i < n; ++i) {
+            if (bounds_[i] == FREE) {
+                continue;
+            }
+            double multiplier = gradient[i];
+            for (size_t j = 0; j < n; ++j) {
+                multiplier += hessian[i][j] * x[j];
+            }
+            const double violation = bounds_[i] == LOWER ? -multiplier : multiplier;
+            if (violation > worst) {
+                worst = violation;
+                release = i;
+            }
+        }
+        if (release == n) {
+            stats_.converged = true;
+            break;
+        }
+        bounds_[release] = FREE;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        solution_[i] = static_cast<float>(x[i]);
+        stats_.activeConstraints += bounds_[i] != FREE ? 1 : 0;
+    }
+}
+
+const float* MpcController::plan() const {
+    return solution_;
+}
+
+const MpcController::Stats& MpcController::stats() const {
+    return stats_;
+}
@@ -1,11 +1,12 @@
-#include "include/PIDController.h"
+#include "include/PidController.h"
 #include <algorithm>
+#include <cmath>
 
 PIDController::PIDController(float kp, float ki, float kd, float outputMin, float outputMax, float integral_max)
     : kp_(kp), ki_(ki), kd_(kd)
     , outputMin_(outputMin), outputMax_(outputMax)
-    , integral_(0.0f), lastError_(0.0f)
-    ,  integral_max_(integral_max)
+    , integral_(0.0f), integral_max_(integral_max)
+    , lastError_(0.0f)
 {}
 
 void PIDController::setGains(float kp, float ki, float kd) {
@@ -19,25 +20,84 @@ void PIDController::setLimits(float outputMin, float outputMax) {
     outputMax_ = outputMax;
 }
 
+void PIDController::setDerivativeFilter(float tau) {
+    derivativeTau_ = std::max(tau, 0.0f);
+}
+
+void PIDController::setSetpointWeights(float b, float c) {
+    setpointWeightP_ = b;
+    setpointWeightD_ = c;
+}
+
+void PIDController::setAntiWindup(AntiWindup mode, float kb) {
+    antiWindup_ = mode;
+    backCalcGain_ = kb;
+}
+
+void PIDController::setFeedForward(float kv, float ka) {
+    kv_ = kv;
+    ka_ = ka;
+}
+
+void PIDController::setRateLimit(float maxRate) {
+    maxRate_ = maxRate;
+}
+
 float PIDController::compute(float setpoint, float measurement, float dt) {
-    float error = setpoint - measurement;
+    return compute(setpoint, measurement, dt, 0.0f, 0.0f);
+}
+
+float PIDController::compute(float setpoint, float measurement, float dt, float velocityRef, float accelRef) {
+    const float error = setpoint - measurement;
 
     // 积分项
+    const float lastIntegral = integral_;
     integral_ += ki_ * error * dt;
     integral_ = std::clamp(integral_, -integral_max_, integral_max_);
 
-    // 微分项
-    float derivative = (error - lastError_) / dt;
+    // 微分项：对 c * setpoint - measurement 求导后经一阶低通，tau = 0 时即原始差分
+    const float derivativeInput = setpointWeightD_ * setpoint - measurement;
+    if (!primed_) {
+        lastDerivativeInput_ = derivativeInput;
+        primed_ = true;
+    }
+    const float rawDerivative = (derivativeInput - lastDerivativeInput_) / dt;
+    lastDerivativeInput_ = derivativeInput;
     lastError_ = error;
+    derivative_ += dt / (derivativeTau_ + dt) * (rawDerivative - derivative_);
 
     // 计算输出
-    float output = kp_ * error + integral_ + kd_ * derivative;
+    const float unsaturated = kp_ * (setpointWeightP_ * setpoint - measurement) + integral_ + kd_ * derivative_
+                            + kv_ * velocityRef + ka_ * accelRef;
 
-    // 限幅
-    return std::clamp(output, outputMin_, outputMax_);
+    // 限幅与变化率限制
+    const float step = maxRate_ > 0.0f ? maxRate_ * dt : INFINITY;
+    const float output = std::clamp(std::clamp(unsaturated, outputMin_, outputMax_),
+                                     lastOutput_ - step, lastOutput_ + step);
+
+    // 抗积分饱和
+    const float excess = output - unsaturated;
+    switch (antiWindup_) {
+        case AntiWindup::BACK_CALCULATION:
+            integral_ = std::clamp(integral_ + backCalcGain_ * excess * dt, -integral_max_, integral_max_);
+            break;
+        case AntiWindup::CONDITIONAL:
+            // excess 与 error 异号说明误差正把输出推向饱和方向
+            integral_ = excess * error < 0.0f ? lastIntegral : integral_;
+            break;
+        case AntiWindup::CLAMP:
+            break;
+    }
+
+    lastOutput_ = output;
+    return output;
 }
 
 void PIDController::reset() {
     integral_ = 0.0f;
     lastError_ = 0.0f;
-}
\ No newline at end of file
+    lastDerivativeInput_ = 0.0f;
+    derivative_ = 0.0f;
+    lastOutput_ = 0.0f;
+    primed_ = false;
+}
@@ -0,0 +1,273 @@
+#include "include/PlantIdentifier.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+constexpr double Z95 = 1.959963984540054;
+
+using Mat3 = std::array<std::array<double, 3>, 3>;
+using Vec3 = std::array<double, 3>;
+
+float signOf(float value) {
+    return static_cast<float>((value > 0.0f) - (value < 0.0f));
+}
+
+// 3x3 矩阵求逆（伴随矩阵法），奇异时返回 false
+bool invert3(const Mat3& m, Mat3& inv) {
+    const double c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    const double c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    const double c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    const double det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+    if (std::abs(det) < 1e-300) {
+        return false;
+    }
+    const double s = 1.0 / det;
+    inv[0][0] = c00 * s;
+    inv[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * s;
+    inv[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * s;
+    inv[1][0] = c01 * s;
+    inv[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * s;
+    inv[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * s;
+    inv[2][0] = c02 * s;
+    inv[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * s;
+    inv[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * s;
+    return true;
+}
+
+// 单个候选延时下的法方程累加量
+struct NormalEquations {
+    Mat3 A{};
+    Vec3 g{};
+    double yy = 0.0;
+    double sy = 0.0;
+    size_t n = 0;
+};
+
+NormalEquations accumulate(const float* torque, const float* omega, size_t count, int delay,
+                           float dt, float deadband) {
+    NormalEquations eq;
+    const double invDt = 1.0 / dt;
+    for (size_t k = static_cast<size_t>(delay); k + 1 < count; ++k) {
+        const float w0 = omega[k];
+        const float w1 = omega[k + 1];
+        // 静摩擦区与过零点不满足模型，剔除
+        if (std::abs(w0) < deadband || std::abs(w1) < deadband || w0 * w1 < 0.0f) {
+            continue;
+        }
+        // 与 PlantModel::step 相同的前向欧拉离散：阻尼项取周期起点的 ω，否则 J、b 有 b·dt/2J 量级的偏差
+        const double y = (w1 - w0) * invDt;
+        const Vec3 phi = {torque[k - delay], -static_cast<double>(w0), -static_cast<double>(signOf(w0))};
+
+        for (int i = 0; i < 3; ++i) {
+            for (int j = i; j < 3; ++j) {
+                eq.A[i][j] += phi[i] * phi[j];
+            }
+            eq.g[i] += phi[i] * y;
+        }
+        eq.yy += y * y;
+        eq.sy += y;
+        ++eq.n;
+    }
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < i; ++j) {
+            eq.A[i][j] = eq.A[j][i];
+        }
+    }
+    return eq;
+}
+
+} // namespace
+
+float PlantModel::step(float omega, float torque, float dt) const {
+    // 静止且驱动力矩不足以克服库仑摩擦时保持静止
+    if (omega == 0.0f && std::abs(torque) <= coulomb) {
+        return 0.0f;
+    }
+    const float direction = omega != 0.0f ? signOf(omega) : signOf(torque);
+    const float accel = (torque - damping * omega - coulomb * direction) / inertia;
+    const float next = omega + accel * dt;
+    // 摩擦不应使速度反向
+    return (omega != 0.0f && next * omega < 0.0f) ? 0.0f : next;
+}
+
+PlantIdentifier::PlantIdentifier(const Options& options) : options_(options) {}
+
+void PlantIdentifier::setOptions(const Options& options) {
+    options_ = options;
+}
+
+IdentificationResult PlantIdentifier::identify(const float* torque, const float* omega, const float* angle,
+                                               size_t count, float dt) const {
+    IdentificationResult result;
+    if (!torque || count < 8 || dt <= 0.0f) {
+        return result;
+    }
+
+    // 角速度来源：测量值或角度差分（处理 ±360° 回绕）
+    std::vector<float> derivedOmega;
+    if (options_.omegaFromAngle && angle) {
+        derivedOmega.resize(count);
+        for (size_t k = 1; k < count; ++k) {
+            double delta = angle[k] - angle[k - 1];
+            delta -= 360.0 * std::round(delta / 360.0);
+            derivedOmega[k] = static_cast<float>(delta * DEG_TO_RAD / dt);
+        }
+        derivedOmega[0] = derivedOmega[1];
+        omega = derivedOmega.data();
+    }
+    if (!omega) {
+        return result;
+    }
+
+    const int maxDelay = std::clamp(options_.maxDelaySamples, 0, static_cast<int>(count / 4));
+
+    double bestCost = std::numeric_limits<double>::infinity();
+    for (int d = 0; d <= maxDelay; ++d) {
+        const NormalEquations eq = accumulate(torque, omega, count, d, dt, options_.omegaDeadband);
+        if (eq.n < 4) {
+            continue;
+        }
+
+        Mat3 inv{};
+        if (!invert3(eq.A, inv)) {
+            continue;
+        }
+
+        Vec3 theta{};
+        for (int i = 0; i < 3; ++i) {
+            theta[i] = inv[i][0] * eq.g[0] + inv[i][1] * eq.g[1] + inv[i][2] * eq.g[2];
+        }
+        if (theta[0] <= 0.0) {
+            continue;
+        }
+
+        // A·θ = g，残差平方和可直接由累加量得到
+        const double rss = std::max(0.0, eq.yy - (theta[0] * eq.g[0] + theta[1] * eq.g[1] + theta[2] * eq.g[2]));
+        const double cost = rss / static_cast<double>(eq.n);
+        if (cost >= bestCost) {
+            continue;
+        }
+        bestCost = cost;
+
+        const double J = 1.0 / theta[0];
+        const double sigma2 = eq.n > 3 ? rss / static_cast<double>(eq.n - 3) : 0.0;
+
+        // delta 方法：J = 1/θ0, b = θ1/θ0, c = θ2/θ0
+        const Vec3 gradJ = {-J * J, 0.0, 0.0};
+        const Vec3 gradB = {-theta[1] * J * J, J, 0.0};
+        const Vec3 gradC = {-theta[2] * J * J, 0.0, J};
+        auto variance = [&](const Vec3& grad) {
+            double v = 0.0;
+            for (int i = 0; i < 3; ++i) {
+                for (int j = 0; j < 3; ++j) {
+                    v += grad[i] * inv[i][j] * grad[j];
+                }
+            }
+            return std::max(0.0, v * sigma2);
+        };
+
+        const double syy = eq.yy - eq.sy * eq.sy / static_cast<double>(eq.n);
+
+        result.valid = true;
+        result.model.inertia = static_cast<float>(J);
+        result.model.damping = static_cast<float>(theta[1] * J);
+        result.model.coulomb = static_cast<float>(theta[2] * J);
+        result.model.delay = static_cast<float>(d * dt);
+        result.inertiaCi = static_cast<float>(Z95 * std::sqrt(variance(gradJ)));
+        result.dampingCi = static_cast<float>(Z95 * std::sqrt(variance(gradB)));
+        result.coulombCi = static_cast<float>(Z95 * std::sqrt(variance(gradC)));
+        result.delaySamples = d;
+        result.residualStd = static_cast<float>(std::sqrt(sigma2));
+        result.r2 = syy > 0.0 ? static_cast<float>(1.0 - rss / syy) : 0.0f;
+        result.samplesUsed = eq.n;
+    }
+
+    return result;
+}
+
+IdentificationResult PlantIdentifier::identify(const std::vector<ExcitationRecorder::Sample>& samples,
+                                               float dt) const {
+    std::vector<float> torque(samples.size());
+    std::vector<float> omega(samples.size());
+    std::vector<float> angle(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        torque[i] = samples[i].torque;
+        omega[i] = samples[i].omega;
+        angle[i] = samples[i].angle;
+    }
+    return identify(torque.data(), omega.data(), angle.data(), samples.size(), dt);
+}
+
+RecursivePlantIdentifier::RecursivePlantIdentifier(float forgetting, int delaySamples, float omegaDeadband)
+    : delaySamples_(std::clamp(delaySamples, 0, MAX_DELAY))
+    , forgetting_(forgetting)
+    , omegaDeadband_(omegaDeadband) {
+    reset();
+}
+
+void RecursivePlantIdentifier::reset(const PlantModel& initial) {
+    theta_ = {1.0f / initial.inertia, initial.damping / initial.inertia, initial.coulomb / initial.inertia};
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            P_[i][j] = i == j ? 1e4f : 0.0f;
+        }
+    }
+    torqueHistory_.fill(0.0f);
+    historyIndex_ = 0;
+    hasLast_ = false;
+    updates_ = 0;
+}
+
+void RecursivePlantIdentifier::update(float torque, float omega, float dt) {
+    constexpr int HISTORY = MAX_DELAY + 1;
+
+    if (hasLast_ && lastDt_ > 0.0f &&
+        std::abs(lastOmega_) >= omegaDeadband_ && std::abs(omega) >= omegaDeadband_ && lastOmega_ * omega > 0.0f) {
+        // 上一周期施加的力矩再往前推 delay 个周期
+        const int index = ((historyIndex_ - 1 - delaySamples_) % HISTORY + HISTORY) % HISTORY;
+        const std::array<float, 3> phi = {torqueHistory_[index], -lastOmega_, -signOf(lastOmega_)};
+        const float y = (omega - lastOmega_) / lastDt_;
+
+        std::array<float, 3> Pphi{};
+        for (int i = 0; i < 3; ++i) {
+            Pphi[i] = P_[i][0] * phi[0] + P_[i][1] * phi[1] + P_[i][2] * phi[2];
+        }
+        const float denom = forgetting_ + phi[0] * Pphi[0] + phi[1] * Pphi[1] + phi[2] * Pphi[2];
+        const float error = y - (phi[0] * theta_[0] + phi[1] * theta_[1] + phi[2] * theta_[2]);
+
+        for (int i = 0; i < 3; ++i) {
+            theta_[i] += Pphi[i] / denom * error;
+        }
+        const float invLambda = 1.0f / forgetting_;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                P_[i][j] = (P_[i][j] - Pphi[i] * Pphi[j] / denom) * invLambda;
+            }
+        }
+        ++updates_;
+    }
+
+    torqueHistory_[historyIndex_] = torque;
+    historyIndex_ = (historyIndex_ + 1) % HISTORY;
+    lastOmega_ = omega;
+    lastDt_ = dt;
+    hasLast_ = true;
+}
+
+PlantModel RecursivePlantIdentifier::model() const {
+    PlantModel model;
+    if (theta_[0] > 0.0f) {
+        model.inertia = 1.0f / theta_[0];
+        model.damping = theta_[1] * model.inertia;
+        model.coulomb = theta_[2] * model.inertia;
+    }
+    model.delay = delaySamples_ * lastDt_;
+    return model;
+}
+
+size_t RecursivePlantIdentifier::updates() const {
+    return updates_;
+}
@@ -0,0 +1,264 @@
+#include "include/SignalGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+// 最大长度 LFSR 的反馈抽头（位序号从 1 开始），下标为阶数
+constexpr uint32_t PRBS_TAPS[17] = {
+    0, 0,
+    (1u << 1) | (1u << 0),                           // 2
+    (1u << 2) | (1u << 1),                           // 3
+    (1u << 3) | (1u << 2),                           // 4
+    (1u << 4) | (1u << 2),                           // 5
+    (1u << 5) | (1u << 4),                           // 6
+    (1u << 6) | (1u << 5),                           // 7
+    (1u << 7) | (1u << 5) | (1u << 4) | (1u << 3),   // 8
+    (1u << 8) | (1u << 4),                           // 9
+    (1u << 9) | (1u << 6),                           // 10
+    (1u << 10) | (1u << 8),                          // 11
+    (1u << 11) | (1u << 10) | (1u << 9) | (1u << 3), // 12
+    (1u << 12) | (1u << 11) | (1u << 10) | (1u << 7),// 13
+    (1u << 13) | (1u << 12) | (1u << 11) | (1u << 1),// 14
+    (1u << 14) | (1u << 13),                         // 15
+    (1u << 15) | (1u << 14) | (1u << 12) | (1u << 3) // 16
+};
+
+int parity(uint32_t value) {
+    value ^= value >> 16;
+    value ^= value >> 8;
+    value ^= value >> 4;
+    value ^= value >> 2;
+    value ^= value >> 1;
+    return static_cast<int>(value & 1u);
+}
+
+} // namespace
+
+bool SignalGenerator::configure(const Config& config, float dt) {
+    if (active_.load(std::memory_order_acquire) || dt <= 0.0f || config.duration <= 0.0f) {
+        return false;
+    }
+
+    config_ = config;
+    dt_ = dt;
+    index_ = 0;
+
+    const size_t samples = std::max<size_t>(1, static_cast<size_t>(std::lround(config.duration / dt)));
+    table_.assign(samples, config.offset);
+
+    switch (config.type) {
+        case Type::STEP:      fillStep();      break;
+        case Type::RAMP:      fillRamp();      break;
+        case Type::SINE:      fillSine();      break;
+        case Type::CHIRP:     fillChirp();     break;
+        case Type::PRBS:      fillPrbs();      break;
+        case Type::MULTISINE: fillMultisine(); break;
+    }
+    return !table_.empty();
+}
+
+void SignalGenerator::start() {
+    if (table_.empty()) {
+        return;
+    }
+    index_ = 0;
+    active_.store(true, std::memory_order_release);
+}
+
+void SignalGenerator::stop() {
+    active_.store(false, std::memory_order_release);
+}
+
+bool SignalGenerator::isActive() const {
+    return active_.load(std::memory_order_acquire);
+}
+
+float SignalGenerator::next() {
+    if (!active_.load(std::memory_order_acquire)) {
+        return 0.0f;
+    }
+
+    const float value = table_[index_];
+    if (++index_ >= table_.size()) {
+        if (config_.loop) {
+            index_ = 0;
+        } else {
+            active_.store(false, std::memory_order_release);
+        }
+    }
+    return value;
+}
+
+float SignalGenerator::valueAt(size_t index) const {
+    return index < table_.size() ? table_[index] : 0.0f;
+}
+
+size_t SignalGenerator::length() const {
+    return table_.size();
+}
+
+size_t SignalGenerator::position() const {
+    return index_;
+}
+
+float SignalGenerator::sampleTime() const {
+    return dt_;
+}
+
+const SignalGenerator::Config& SignalGenerator::config() const {
+    return config_;
+}
+
+const std::vector<float>& SignalGenerator::table() const {
+    return table_;
+}
+
+void SignalGenerator::fillStep() {
+    const size_t start = static_cast<size_t>(std::lround(config_.delay / dt_));
+    for (size_t i = start; i < table_.size(); ++i) {
+        table_[i] = config_.offset + config_.amplitude;
+    }
+}
+
+void SignalGenerator::fillRamp() {
+    const size_t start = static_cast<size_t>(std::lround(config_.delay / dt_));
+    if (start >= table_.size()) {
+        return;
+    }
+    const double span = static_cast<double>(table_.size() - start);
+    for (size_t i = start; i < table_.size(); ++i) {
+        table_[i] = config_.offset + config_.amplitude * static_cast<float>((i - start + 1) / span);
+    }
+}
+
+void SignalGenerator::fillSine() {
+    const double w = 2.0 * PI * config_.freqStart;
+    for (size_t i = 0; i < table_.size(); ++i) {
+        table_[i] = config_.offset + config_.amplitude * static_cast<float>(std::sin(w * i * dt_));
+    }
+}
+
+void SignalGenerator::fillChirp() {
+    const double f0 = std::max(1e-3f, config_.freqStart);
+    const double f1 = std::max(1e-3f, config_.freqEnd);
+    const double T = config_.duration;
+
+    // 指数扫频：每个频程停留时间相同，低频段能量更充足
+    const double k = std::log(f1 / f0);
+    for (size_t i = 0; i < table_.size(); ++i) {
+        const double t = i * static_cast<double>(dt_);
+        const double phase = std::abs(k) < 1e-9
+            ? 2.0 * PI * f0 * t
+            : 2.0 * PI * f0 * T / k * (std::exp(k * t / T) - 1.0);
+        table_[i] = config_.offset + config_.amplitude * static_cast<float>(std::sin(phase));
+    }
+}
+
+void SignalGenerator::fillPrbs() {
+    const int order = std::clamp(config_.prbsOrder, 2, 16);
+    const size_t hold = static_cast<size_t>(std::max(1, config_.prbsHold));
+    const size_t period = ((size_t{1} << order) - 1) * hold;
+
+    // 只保留整数个周期，保证频谱干净；时长不足一个周期时按一个周期生成
+    const size_t periods = std::max<size_t>(1, table_.size() / period);
+    table_.assign(periods * period, config_.offset);
+
+    const uint32_t mask = (1u << order) - 1u;
+    uint32_t state = mask;
+    for (size_t i = 0; i < table_.size(); i += hold) {
+        const float level = (state & 1u) ? config_.amplitude : -config_.amplitude;
+        std::fill_n(table_.begin() + static_cast<std::ptrdiff_t>(i), hold, config_.offset + level);
+        const uint32_t feedback = static_cast<uint32_t>(parity(state & PRBS_TAPS[order]));
+        state = ((state << 1) | feedback) & mask;
+    }
+}
+
+void SignalGenerator::fillMultisine() {
+    // 频率取 1/T 的整数倍，播放整周期时不产生频谱泄漏
+    const double T = table_.size() * static_cast<double>(dt_);
+    const double f0 = 1.0 / T;
+    const double nyquist = 0.5 / dt_;
+    const double fStart = std::max(static_cast<double>(config_.freqStart), f0);
+    const double fEnd = std::min(static_cast<double>(config_.freqEnd), nyquist);
+    const int count = std::max(1, config_.multisineCount);
+
+    std::vector<long> harmonics;
+    harmonics.reserve(count);
+    for (int k = 0; k < count; ++k) {
+        const double ratio = count > 1 ? static_cast<double>(k) / (count - 1) : 0.0;
+        const double f = fStart * std::pow(fEnd / fStart, ratio);
+        const long h = std::max(1L, std::lround(f / f0));
+        if (harmonics.empty() || harmonics.back() != h) {
+            harmonics.push_back(h);
+        }
+    }
+
+    const double K = static_cast<double>(harmonics.size());
+    std::vector<double> signal(table_.size(), 0.0);
+    double peak = 0.0;
+    for (size_t i = 0; i < table_.size(); ++i) {
+        const double t = i * static_cast<double>(dt_);
+        double value = 0.0;
+        for (size_t k = 0; k < harmonics.size(); ++k) {
+            // Schroeder 相位，降低峰值因子
+            const double phase = -PI * static_cast<double>(k) * static_cast<double>(k + 1) / K;
+            value += std::cos(2.0 * PI * harmonics[k] * f0 * t + phase);
+        }
+        signal[i] = value;
+        peak = std::max(peak, std::abs(value));
+    }
+
+    const double scale = peak > 0.0 ? config_.amplitude / peak : 0.0;
+    for (size_t i = 0; i < table_.size(); ++i) {
+        table_[i] = config_.offset + static_cast<float>(signal[i] * scale);
+    }
+}
+
+void ExcitationRecorder::reserve(size_t capacity) {
+    samples_.clear();
+    samples_.reserve(capacity);
+    limit_ = capacity;
+}
+
+void ExcitationRecorder::clear() {
+    samples_.clear();
+}
+
+bool ExcitationRecorder::record(const Sample& sample) {
+    if (samples_.size() >= limit_) {
+        return false;
+    }
+    samples_.push_back(sample);
+    return true;
+}
+
+size_t ExcitationRecorder::size() const {
+    return samples_.size();
+}
+
+bool ExcitationRecorder::full() const {
+    return samples_.size() >= limit_;
+}
+
+const std::vector<ExcitationRecorder::Sample>& ExcitationRecorder::samples() const {
+    return samples_;
+}
+
+bool ExcitationRecorder::saveCsv(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    file << "time,excitation,reference,torque,angle,omega\n";
+    for (const auto& s : samples_) {
+        file << s.time << ',' << s.excitation << ',' << s.reference << ','
+             << s.torque << ',' << s.angle << ',' << s.omega << '\n';
+    }
+    return static_cast<bool>(file);
+}
@@ -1,6 +1,7 @@
 #include "include/debug.h"
 #include "include/ui.h"
 #include "motor_manager.h"
+#include "profiler.h"
 #include "include/MotorControl.h"
 #include "imgui.h"
 
@@ -24,6 +25,38 @@ void Debug_init() {
                                        DebugInterface::InputType::INPUT_BOX);
     debugInterface.addEditableVariable("kd", &SpeedController.kd_, -500.0f, 500.0f, 0.01f,
                                        DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("angle_ref", &angle_ref, -36000.0f, 36000.0f, 0.1f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("multi_turn", &multi_turn, 0.0f, 1.0f, 1.0f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("sequence", &sequence_request, 0.0f, 1.0f, 1.0f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("profile_mode", &profile_mode, 0.0f, 1.0f, 1.0f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("profile_vel", &profile_vel, 0.1f, 200.0f, 0.1f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("profile_acc", &profile_acc, 1.0f, 5000.0f, 1.0f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("profile_jerk", &profile_jerk, 0.0f, 100000.0f, 10.0f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("angle_mode", &angle_mode, 0.0f, 1.0f, 1.0f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("autotune", &autotune_request, 0.0f, 1.0f, 1.0f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("latency_comp", &latency_comp, 0.0f, 1.0f, 1.0f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("use_estimator", &use_estimator, 0.0f, 1.0f, 1.0f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("dob_mode", &dob_mode, 0.0f, 1.0f, 1.0f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("dob_bandwidth", &dob_bandwidth, 1.0f, 50.0f, 1.0f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("mpc_mode", &mpc_mode, 0.0f, 1.0f, 1.0f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("friction_learn", &friction_learn, 0.0f, 1.0f, 1.0f,
+                                       DebugInterface::InputType::INPUT_BOX);
+    debugInterface.addEditableVariable("friction_comp", &friction_comp, 0.0f, 1.0f, 1.0f,
+                                       DebugInterface::InputType::INPUT_BOX);
 
     // ========== 添加波形监控变量 ==========
     debugInterface.addWatchVariable("角速度反馈", &omega_watch,
@@ -33,6 +66,18 @@ void Debug_init() {
     // ========== 添加数值监控变量 ==========
     debugInterface.addWatchVariable("角速度反馈", &omega_watch,
                                     DebugInterface::ViewMode::NUMERIC, "rad/s");
+    debugInterface.addWatchVariable("采样间隔", &loop_dt_watch,
+                                    DebugInterface::ViewMode::NUMERIC, "ms");
+    debugInterface.addWatchVariable("角加速度", &accel_watch,
+                                    DebugInterface::ViewMode::NUMERIC, "rad/s²");
+    debugInterface.addWatchVariable("圈数", &turns_watch,
+                                    DebugInterface::ViewMode::NUMERIC, "");
+    debugInterface.addWatchVariable("扰动力矩", &disturbance_watch,
+                                    DebugInterface::ViewMode::NUMERIC, "Nm");
+    debugInterface.addWatchVariable("MPC 迭代", &mpc_iterations_watch,
+                                    DebugInterface::ViewMode::NUMERIC, "");
+    debugInterface.addWatchVariable("前馈补偿", &friction_watch,
+                                    DebugInterface::ViewMode::NUMERIC, "Nm");
 
     // ========== 配置波形显示 ==========
     DebugInterface::WaveformConfig config;
@@ -54,6 +99,7 @@ void Debug_update() {
 }
 
 void debugThreadFunction() {
+    profiler::setThreadName("debug");
     Debug_init();
 
     while (debugThreadRunning) {
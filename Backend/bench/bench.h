@@ -0,0 +1,138 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+// 阻止编译器把被测代码当作无用计算优化掉
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct Result {
+    std::string name;
+    size_t iterations;
+    double nsPerOp;
+};
+
+// 先预热再计时，返回每次调用的平均耗时
+template<typename F>
+Result run(const std::string& name, size_t iterations, F&& body) {
+    for (size_t i = 0; i < iterations / 10 + 1; ++i) {
+        body(i);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        body(i);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return {name, iterations, ns / static_cast<double>(iterations)};
+}
+
+inline void print(const Result& result) {
+    std::printf("%-40s %12zu iters %12.2f ns/op\n", result.name.c_str(), result.iterations, result.nsPerOp);
+}
+
+// 延时分布统计（单位与输入一致）
+struct Percentiles {
+    double p50;
+    double p99;
+    double p999;
+    double max;
+};
+
+inline Percentiles percentiles(std::vector<double> samples) {
+    if (samples.empty()) {
+        return {0.0, 0.0, 0.0, 0.0};
+    }
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) {
+        return samples[std::min(samples.size() - 1, static_cast<size_t>(q * static_cast<double>(samples.size())))];
+    };
+    return {at(0.50), at(0.99), at(0.999), samples.back()};
+}
+
+// 结果汇总：逐条打印，并可写成 JSON 供不同提交之间对比回归
+class Report {
+public:
+    void add(const Result& result) {
+        print(result);
+        entries_.push_back({result.name, result.iterations, result.nsPerOp, {}, ""});
+    }
+
+    void add(const std::string& name, size_t samples, const Percentiles& p, const std::string& unit) {
+        std::printf("%-40s %12zu samples  p50 %9.2f  p99 %9.2f  p99.9 %9.2f  max %9.2f %s\n",
+                    name.c_str(), samples, p.p50, p.p99, p.p999, p.max, unit.c_str());
+        entries_.push_back({name, samples, 0.0, p, unit});
+    }
+
+    // 名称只含 ASCII 可打印字符，按 JSON 字符串规则转义引号与反斜杠
+    bool writeJson(const std::string& path) const {
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) {
+            std::fprintf(stderr, "bench: cannot write %s\n", path.c_str());
+            return false;
+        }
+        std::fprintf(file, "{\n  \"benchmarks\": [");
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            const Entry& e = entries_[i];
+            std::string name;
+            for (char c : e.name) {
+                if (c == '"' || c == '\\') {
+                    name += '\\';
+                }
+                name += c;
+            }
+            std::fprintf(file, "%s\n    {\"name\": \"%s\", ", i == 0 ? "" : ",", name.c_str());
+            if (e.unit.empty()) {
+                std::fprintf(file, "\"iterations\": %zu, \"ns_per_op\": %.3f}", e.count, e.nsPerOp);
+            } else {
+                std::fprintf(file, "\"samples\": %zu, \"unit\": \"%s\", \"p50\": %.3f, \"p99\": %.3f, "
+                                   "\"p999\": %.3f, \"max\": %.3f}",
+                             e.count, e.unit.c_str(), e.latency.p50, e.latency.p99, e.latency.p999, e.latency.max);
+            }
+        }
+        std::fprintf(file, "\n  ]\n}\n");
+        return std::fclose(file) == 0;
+    }
+
+private:
+    struct Entry {
+        std::string name;
+        size_t count;
+        double nsPerOp;
+        Percentiles latency;
+        std::string unit;  // 为空表示吞吐结果，否则为延时分布的单位
+    };
+
+    std::vector<Entry> entries_;
+};
+
+// 命令行中 "--json <path>" 指定的输出路径，未指定时返回空串
+inline std::string jsonPath(int argc, char** argv) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--json") {
+            return argv[i + 1];
+        }
+    }
+    return {};
+}
+
+} // namespace bench
+
+#endif // BENCH_H
@@ -0,0 +1,82 @@
+#include "bench.h"
+#include "include/BasicPidController.h"
+#include "include/PidController.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr size_t ITERATIONS = 5'000'000;
+constexpr size_t SIGNAL_LENGTH = 4096;
+constexpr float DT = 0.001f;
+
+// 归一化到 [-0.5, 0.5) 的参考 / 测量序列，Q15/Q31 也能表示
+struct Signals {
+    std::vector<float> setpoint;
+    std::vector<float> measurement;
+};
+
+Signals makeSignals() {
+    Signals s;
+    s.setpoint.resize(SIGNAL_LENGTH);
+    s.measurement.resize(SIGNAL_LENGTH);
+    for (size_t i = 0; i < SIGNAL_LENGTH; ++i) {
+        s.setpoint[i] = 0.4f * std::sin(0.01f * static_cast<float>(i));
+        s.measurement[i] = 0.35f * std::sin(0.01f * static_cast<float>(i) - 0.2f);
+    }
+    return s;
+}
+
+template<typename T>
+bench::Result runBasic(const char* name, const Signals& s) {
+    BasicPIDController<T> pid(0.6f, 2.0f, 0.0005f, DT, -0.9f, 0.9f, 0.5f);
+    std::vector<T> sp(SIGNAL_LENGTH), meas(SIGNAL_LENGTH);
+    for (size_t i = 0; i < SIGNAL_LENGTH; ++i) {
+        sp[i] = T(s.setpoint[i]);
+        meas[i] = T(s.measurement[i]);
+    }
+    return bench::run(name, ITERATIONS, [&](size_t i) {
+        const size_t k = i & (SIGNAL_LENGTH - 1);
+        bench::doNotOptimize(pid.compute(sp[k], meas[k]));
+    });
+}
+
+// 与 double 参考实现逐点比较，给出最大偏差（单位：输出量）
+template<typename T>
+double maxDeviation(const Signals& s) {
+    BasicPIDController<T> pid(0.6f, 2.0f, 0.0005f, DT, -0.9f, 0.9f, 0.5f);
+    BasicPIDController<double> ref(0.6f, 2.0f, 0.0005f, DT, -0.9f, 0.9f, 0.5f);
+    double worst = 0.0;
+    for (size_t i = 0; i < SIGNAL_LENGTH; ++i) {
+        const double a = static_cast<double>(pid.compute(T(s.setpoint[i]), T(s.measurement[i])));
+        const double b = ref.compute(s.setpoint[i], s.measurement[i]);
+        worst = std::max(worst, std::abs(a - b));
+    }
+    return worst;
+}
+
+} // namespace
+
+int main() {
+    const Signals signals = makeSignals();
+
+    PIDController legacy(0.6f, 2.0f, 0.0005f, -0.9f, 0.9f, 0.5f);
+    bench::print(bench::run("PIDController::compute", ITERATIONS, [&](size_t i) {
+        const size_t k = i & (SIGNAL_LENGTH - 1);
+        bench::doNotOptimize(legacy.compute(signals.setpoint[k], signals.measurement[k], DT));
+    }));
+
+    bench::print(runBasic<float>("BasicPIDController<float>", signals));
+    bench::print(runBasic<double>("BasicPIDController<double>", signals));
+    bench::print(runBasic<q15_t>("BasicPIDController<q15_t>", signals));
+    bench::print(runBasic<q31_t>("BasicPIDController<q31_t>", signals));
+    bench::print(runBasic<q16_16_t>("BasicPIDController<q16_16_t>", signals));
+
+    std::printf("\nmax |output - double reference|\n");
+    std::printf("  float    %.3e\n", maxDeviation<float>(signals));
+    std::printf("  q15_t    %.3e\n", maxDeviation<q15_t>(signals));
+    std::printf("  q31_t    %.3e\n", maxDeviation<q31_t>(signals));
+    std::printf("  q16_16_t %.3e\n", maxDeviation<q16_16_t>(signals));
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include "bench.h"
+#include "angle_tracker.h"
+#include "state_estimator.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+// 估计器耗时与精度：单电机逐帧更新、SoA 批量更新（每电机均摊）、外推；
+// 精度用带噪声的仿真电机比较原始测量与滤波结果的均方根误差
+
+namespace {
+
+constexpr size_t ITERATIONS = 2'000'000;
+constexpr size_t BANK_SIZE = 64;
+constexpr size_t SIGNAL_LENGTH = 4096;
+constexpr float DT = 0.001f;
+constexpr double PI = 3.14159265358979323846;
+constexpr double DEG_PER_RAD = 180.0 / PI;
+
+// 仿真电机的真实轨迹与带噪声的反馈（角度按模拟器的 ±360° 回绕）
+struct Trajectory {
+    std::vector<double> angle;   // rad，未回绕
+    std::vector<float> omega;
+    std::vector<float> accel;
+    std::vector<float> measuredAngle;  // 度，回绕后
+    std::vector<double> measuredPosition;  // 度，由 AngleTracker 展开
+    std::vector<float> measuredOmega;
+};
+
+Trajectory simulate(size_t length, float angleNoiseDeg, float omegaNoise, unsigned seed) {
+    Trajectory t;
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> angleNoise(0.0f, angleNoiseDeg);
+    std::normal_distribution<float> omegaNoiseDist(0.0f, omegaNoise);
+
+    double angle = 0.0;
+    float omega = 0.0f;
+    AngleTracker tracker;
+    for (size_t i = 0; i < length; ++i) {
+        // 正弦加减速叠加每 0.5 s 一次的加速度阶跃，平均转速足以多次跨越回绕
+        const float time = static_cast<float>(i) * DT;
+        const float accel = 40.0f * std::sin(2.0f * static_cast<float>(PI) * 1.5f * time)
+                          + ((i / 500) % 2 ? 20.0f : -15.0f);
+        omega += accel * DT;
+        angle += omega * DT;
+
+        t.angle.push_back(angle);
+        t.omega.push_back(omega);
+        t.accel.push_back(accel);
+        const double wrapped = std::fmod(angle * DEG_PER_RAD, 360.0);
+        t.measuredAngle.push_back(static_cast<float>(wrapped) + angleNoise(rng));
+        t.measuredPosition.push_back(tracker.update(t.measuredAngle.back()));
+        t.measuredOmega.push_back(omega + omegaNoiseDist(rng));
+    }
+    return t;
+}
+
+double rms(double sum, size_t count) {
+    return std::sqrt(sum / static_cast<double>(count));
+}
+
+void accuracy() {
+    constexpr size_t LENGTH = 20'000;
+    constexpr size_t SETTLE = 200;
+    const Trajectory t = simulate(LENGTH, 0.1f, 0.2f, 1);
+
+    EstimatorConfig config;
+    config.angleNoise = 0.1f;
+    config.omegaNoise = 0.2f;
+    StateEstimator estimator(config);
+
+    double rawAngle = 0.0, rawOmega = 0.0, rawAccel = 0.0;
+    double kfAngle = 0.0, kfOmega = 0.0, kfAccel = 0.0;
+    double unwrapError = 0.0;
+    for (size_t i = 0; i < LENGTH; ++i) {
+        estimator.update(t.measuredPosition[i], t.measuredOmega[i], static_cast<int64_t>(i + 1) * 1'000'000);
+        if (i < SETTLE) {
+            continue;
+        }
+        const EstimatedState& s = estimator.state();
+        const double truthDeg = t.angle[i] * DEG_PER_RAD;
+        double rawError = t.measuredAngle[i] - std::fmod(truthDeg, 360.0);
+        rawError -= 360.0 * std::round(rawError / 360.0);
+        const double rawDiff = (t.measuredOmega[i] - t.measuredOmega[i - 1]) / DT;
+
+        rawAngle += rawError * rawError;
+        rawOmega += std::pow(t.measuredOmega[i] - t.omega[i], 2);
+        rawAccel += std::pow(rawDiff - t.accel[i], 2);
+        kfAngle += std::pow(s.angle - truthDeg, 2);
+        kfOmega += std::pow(s.omega - t.omega[i], 2);
+        kfAccel += std::pow(s.acceleration - t.accel[i], 2);
+        unwrapError = std::max(unwrapError, std::abs(s.angle - truthDeg));
+    }
+
+    const size_t n = LENGTH - SETTLE;
+    std::printf("\nRMS error over %zu samples (%.0f turns)\n", n, t.angle.back() / (2.0 * PI));
+    std::printf("  %-14s %12s %12s\n", "", "raw", "estimator");
+    std::printf("  %-14s %12.4f %12.4f\n", "angle (deg)", rms(rawAngle, n), rms(kfAngle, n));
+    std::printf("  %-14s %12.4f %12.4f\n", "omega (rad/s)", rms(rawOmega, n), rms(kfOmega, n));
+    std::printf("  %-14s %12.2f %12.2f\n", "accel (rad/s2)", rms(rawAccel, n), rms(kfAccel, n));
+    std::printf("  max unwrapped angle error %.4f deg\n", unwrapError);
+}
+
+} // namespace
+
+int main() {
+    const Trajectory t = simulate(SIGNAL_LENGTH, 0.05f, 0.05f, 2);
+
+    StateEstimator single;
+    bench::print(bench::run("StateEstimator::update", ITERATIONS, [&](size_t i) {
+        const size_t k = i & (SIGNAL_LENGTH - 1);
+        single.update(t.measuredPosition[k], t.measuredOmega[k], static_cast<int64_t>(i + 1) * 1'000'000);
+        bench::doNotOptimize(single.state());
+    }));
+
+    AngleTracker tracker;
+    bench::print(bench::run("AngleTracker::update", ITERATIONS, [&](size_t i) {
+        bench::doNotOptimize(tracker.update(t.measuredAngle[i & (SIGNAL_LENGTH - 1)]));
+    }));
+
+    const EstimatedState snapshot = single.state();
+    bench::print(bench::run("StateEstimator::extrapolate", ITERATIONS, [&](size_t i) {
+        bench::doNotOptimize(StateEstimator::extrapolate(snapshot, snapshot.timeNs + static_cast<int64_t>(i & 0xFFFF) * 100));
+    }));
+
+    // 各电机取轨迹上不同的起点
+    StateEstimatorBank bank(BANK_SIZE);
+    std::vector<double> positions(BANK_SIZE * SIGNAL_LENGTH);
+    std::vector<float> omegas(BANK_SIZE * SIGNAL_LENGTH);
+    for (size_t k = 0; k < SIGNAL_LENGTH; ++k) {
+        for (size_t m = 0; m < BANK_SIZE; ++m) {
+            const size_t source = (k + m * 37) & (SIGNAL_LENGTH - 1);
+            positions[k * BANK_SIZE + m] = t.measuredPosition[source];
+            omegas[k * BANK_SIZE + m] = t.measuredOmega[source];
+        }
+    }
+    const size_t bankIterations = ITERATIONS / BANK_SIZE;
+    bench::Result batched = bench::run("StateEstimatorBank::update", bankIterations, [&](size_t i) {
+        const size_t k = i & (SIGNAL_LENGTH - 1);
+        bank.update(&positions[k * BANK_SIZE], &omegas[k * BANK_SIZE], DT);
+        bench::doNotOptimize(bank.state(0));
+    });
+    bench::print(batched);
+    std::printf("  %zu motors, %.2f ns/motor\n", BANK_SIZE, batched.nsPerOp / BANK_SIZE);
+
+    std::vector<double> predictedAngle(BANK_SIZE);
+    std::vector<float> predictedOmega(BANK_SIZE);
+    bench::Result predicted = bench::run("StateEstimatorBank::predict", bankIterations, [&](size_t i) {
+        bank.predict(DT * static_cast<float>(i & 7) * 0.125f, predictedAngle.data(), predictedOmega.data());
+        bench::doNotOptimize(predictedAngle[0]);
+    });
+    bench::print(predicted);
+    std::printf("  %zu motors, %.2f ns/motor\n", BANK_SIZE, predicted.nsPerOp / BANK_SIZE);
+
+    accuracy();
+    return 0;
+}
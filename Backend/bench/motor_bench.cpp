@@ -0,0 +1,354 @@
+#include "bench.h"
+#include "include/PidController.h"
+#include "motor.h"
+#include "motor_manager.h"
+#include "packet_framer.h"
+#include "socket_compat.h"
+#include "tcp_transport.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <thread>
+
+// 上位机各条数据路径的基准：反馈解析、指令编码、控制计算、电机查找、调试波形，
+// 以及经真实 Motor 收发线程的 TCP 回环往返。
+// 用法：motor_bench [--json <path>]，JSON 结果可用于不同提交之间的回归对比
+
+namespace {
+
+constexpr uint8_t MOTOR_ID = 1;
+constexpr size_t STREAM_FRAMES = 200'000;
+constexpr size_t CHUNK = 64;           // 模拟 socket 每次交付的字节数
+constexpr int LOOPBACK_PORT = 16100;
+constexpr int LOOPBACK_ROUND_TRIPS = 2000;
+
+// 反馈字节流：noisy 时约 10% 的帧前插入 1~5 个垃圾字节（不含帧头），约 5% 的帧有一个字节出错
+struct Stream {
+    std::vector<uint8_t> bytes;
+    size_t validFrames = 0;
+};
+
+Stream makeStream(const ProtocolOptions& options, bool noisy) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    Stream stream;
+    uint8_t frame[MAX_FEEDBACK_SIZE];
+    FeedbackMessage feedback;
+    feedback.motorId = MOTOR_ID;
+    feedback.fields = protocol::FeedbackAngle::mask | protocol::FeedbackOmega::mask;
+    for (size_t i = 0; i < STREAM_FRAMES; ++i) {
+        feedback.angle = std::fmod(0.36f * static_cast<float>(i), 360.0f);
+        feedback.omega = 6.28f;
+        const size_t size = encodeFeedback(feedback, options, frame);
+        if (noisy && uniform(rng) < 0.10f) {
+            const int garbage = 1 + static_cast<int>(rng() % 5);
+            for (int k = 0; k < garbage; ++k) {
+                stream.bytes.push_back(static_cast<uint8_t>(rng() % FEEDBACK_HEADER));
+            }
+        }
+        if (noisy && uniform(rng) < 0.05f) {
+            frame[2 + rng() % (size - 3)] ^= 0x5A;
+        } else {
+            ++stream.validFrames;
+        }
+        stream.bytes.insert(stream.bytes.end(), frame, frame + size);
+    }
+    return stream;
+}
+
+bench::Result runFramer(const std::string& name, const ProtocolOptions& options, const Stream& stream) {
+    FeedbackFramer framer(256, options.version);
+    FeedbackFramer::Feedback feedback{};
+    size_t frames = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t offset = 0; offset < stream.bytes.size(); offset += CHUNK) {
+        framer.push(stream.bytes.data() + offset, std::min(CHUNK, stream.bytes.size() - offset));
+        while (framer.next(feedback)) {
+            bench::doNotOptimize(feedback);
+            ++frames;
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return {name, frames, std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(frames)};
+}
+
+// 从内存回放字节流的传输层。接收线程只在处理完上一块之后才再次调用 receive，
+// 因此回放结束后的第一次调用时刻即为全部数据处理完毕的时刻
+class ReplayTransport : public Transport {
+public:
+    explicit ReplayTransport(const std::vector<uint8_t>& stream) :
+        stream_(stream), position_(0), open_(false), finished_(false) {
+    }
+
+    bool open() override {
+        open_ = true;
+        return true;
+    }
+    void close() override { open_ = false; }
+    [[nodiscard]] bool isOpen() const override { return open_; }
+    bool send(const uint8_t*, size_t) override { return true; }
+
+    int receive(uint8_t* data, size_t size, int) override {
+        if (position_ == 0) {
+            start_ = std::chrono::steady_clock::now();
+        }
+        if (position_ >= stream_.size()) {
+            if (!finished_) {
+                end_ = std::chrono::steady_clock::now();
+                finished_ = true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return 0;
+        }
+        const size_t n = std::min({size, CHUNK, stream_.size() - position_});
+        std::memcpy(data, stream_.data() + position_, n);
+        position_ += n;
+        return static_cast<int>(n);
+    }
+
+    [[nodiscard]] std::string describe() const override { return "replay"; }
+
+    [[nodiscard]] bool finished() const { return finished_; }
+    [[nodiscard]] double elapsedNs() const {
+        return std::chrono::duration<double, std::nano>(end_ - start_).count();
+    }
+
+private:
+    const std::vector<uint8_t>& stream_;
+    size_t position_;
+    bool open_;
+    std::atomic<bool> finished_;
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::steady_clock::time_point end_;
+};
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+// 经 Motor 的接收线程走完整的 processReceivedData：组帧、时钟同步、圈数展开、卡尔曼滤波、状态发布
+// 校验错误日志照常格式化，但丢弃输出，避免终端写入主导计时
+bench::Result runProcessReceived(const std::string& name, const ProtocolOptions& options, const Stream& stream) {
+    NullBuffer discard;
+    std::streambuf* console = std::cerr.rdbuf(&discard);
+    Motor motor(MOTOR_ID);
+    motor.setProtocol(options);
+    auto transport = std::make_unique<ReplayTransport>(stream.bytes);
+    ReplayTransport* replay = transport.get();
+    motor.connect(std::move(transport));
+    while (!replay->finished()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const uint64_t frames = motor.getState().sequence;
+    const double ns = replay->elapsedNs();
+    motor.disconnect();
+    std::cerr.rdbuf(console);
+    // 噪声流中的垃圾字节偶尔会被拼成合法帧，只校验无噪声流
+    if (stream.validFrames == STREAM_FRAMES && frames != stream.validFrames) {
+        std::fprintf(stderr, "%s: accepted %llu frames, expected %zu\n", name.c_str(),
+                     static_cast<unsigned long long>(frames), stream.validFrames);
+    }
+    return {name, static_cast<size_t>(frames), ns / static_cast<double>(std::max<uint64_t>(frames, 1))};
+}
+
+// 波形数据路径：DebugInterface::updateData 的历史更新与 renderWaveformArea 的窗口筛选。
+// 两者依赖 ImGui 上下文无法在基准中直接调用，这里按原实现复刻同样的容器操作
+struct DataPoint {
+    float timestamp;
+    float value;
+};
+
+constexpr size_t WAVEFORM_VARIABLES = 8;
+constexpr float WAVEFORM_WINDOW = 2.0f;  // 与 debug.cpp 中的 timeWindow 一致
+
+void runWaveform(bench::Report& report, float sampleRate) {
+    std::vector<std::deque<DataPoint>> histories(WAVEFORM_VARIABLES);
+    const float retention = WAVEFORM_WINDOW * 2.0f;
+    size_t sample = 0;  // 预热与计时连续采样，时间戳单调递增
+    auto update = [&](size_t) {
+        const float timestamp = static_cast<float>(sample++) / sampleRate;
+        for (size_t v = 0; v < WAVEFORM_VARIABLES; ++v) {
+            auto& history = histories[v];
+            history.push_back({timestamp, std::sin(timestamp + static_cast<float>(v))});
+            if (history.size() > 2) {
+                while (!history.empty() && history.front().timestamp < timestamp - retention) {
+                    history.erase(history.begin());
+                }
+            }
+        }
+    };
+
+    const size_t iterations = static_cast<size_t>(sampleRate * 60.0f);
+    char name[64];
+    std::snprintf(name, sizeof(name), "waveform update %zu vars @%.0fHz", WAVEFORM_VARIABLES, sampleRate);
+    report.add(bench::run(name, iterations, update));
+
+    // 历史已填满保留时长，每帧按时间窗口筛选后拷贝到绘制用的数组
+    const float now = static_cast<float>(sample) / sampleRate;
+    std::snprintf(name, sizeof(name), "waveform render prep %zu vars @%.0fHz", WAVEFORM_VARIABLES, sampleRate);
+    report.add(bench::run(name, 20'000, [&](size_t) {
+        for (const auto& history : histories) {
+            std::vector<float> times, values;
+            const float timeStart = now - WAVEFORM_WINDOW;
+            for (const auto& point : history) {
+                if (point.timestamp >= timeStart) {
+                    times.push_back(point.timestamp);
+                    values.push_back(point.value);
+                }
+            }
+            bench::doNotOptimize(times.data());
+            bench::doNotOptimize(values.data());
+        }
+    }));
+}
+
+// 仿真端：每收到一条 v1 指令就回一帧反馈，角度字段回显指令力矩
+void loopbackPlant(socket_t server) {
+    socket_t client = accept(server, nullptr, nullptr);
+    // 仿真端关闭 Nagle，计时只反映上位机一侧的路径
+    int noDelay = 1;
+    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+    uint8_t buffer[256];
+    size_t pending = 0;
+    FeedbackMessage feedback;
+    feedback.motorId = MOTOR_ID;
+    uint8_t frame[FEEDBACK_PACKET_SIZE];
+    while (true) {
+        const auto n = recv(client, reinterpret_cast<char*>(buffer + pending), sizeof(buffer) - pending, 0);
+        if (n <= 0) {
+            break;
+        }
+        pending += static_cast<size_t>(n);
+        size_t offset = 0;
+        while (pending - offset >= COMMAND_PACKET_SIZE) {
+            std::memcpy(&feedback.angle, buffer + offset + 2, sizeof(float));
+            encodeFeedback(feedback, ProtocolOptions{}, frame);
+            send(client, reinterpret_cast<const char*>(frame), FEEDBACK_PACKET_SIZE, SOCKET_SEND_FLAGS);
+            offset += COMMAND_PACKET_SIZE;
+        }
+        std::memmove(buffer, buffer + offset, pending - offset);
+        pending -= offset;
+    }
+    closeSocket(client);
+}
+
+// 端到端往返：setTorque 到对应反馈出现在 getState 中的时间，
+// 包含发送线程的 1 ms 发送节拍、TCP 回环、接收线程的解析与状态发布
+void runLoopback(bench::Report& report) {
+    socket_t server = socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    setsockopt(server, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(LOOPBACK_PORT));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(server, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(server, 1) != 0) {
+        std::fprintf(stderr, "loopback: cannot listen on port %d\n", LOOPBACK_PORT);
+        closeSocket(server);
+        return;
+    }
+    std::thread plant(loopbackPlant, server);
+
+    std::vector<double> samples;
+    samples.reserve(LOOPBACK_ROUND_TRIPS);
+    {
+        Motor motor(MOTOR_ID);
+        if (motor.connect("127.0.0.1", LOOPBACK_PORT)) {
+            for (int i = 1; i <= LOOPBACK_ROUND_TRIPS; ++i) {
+                // 力矩取不会被安全层限幅的小值，逐次不同以区分反馈
+                const float torque = 1e-4f * static_cast<float>(i % 1000 + 1);
+                const auto start = std::chrono::steady_clock::now();
+                motor.setTorque(torque);
+                const auto deadline = start + std::chrono::seconds(1);
+                while (motor.getState().angle != torque && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::yield();
+                }
+                samples.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            }
+        }
+    }
+    closeSocket(server);
+    plant.join();
+    report.add("loopback setTorque -> feedback (tcp)", samples.size(), bench::percentiles(samples), "us");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    initializeSockets();
+    bench::Report report;
+
+    ProtocolOptions v1;
+    ProtocolOptions v2;
+    v2.version = ProtocolVersion::V2;
+    v2.crc = CrcKind::CRC32C;
+    const Stream v1Clean = makeStream(v1, false);
+    const Stream v1Noisy = makeStream(v1, true);
+    const Stream v2Clean = makeStream(v2, false);
+
+    // 反馈解析
+    report.add(runFramer("framer v1 clean (per frame)", v1, v1Clean));
+    report.add(runFramer("framer v1 noisy (per frame)", v1, v1Noisy));
+    report.add(runFramer("framer v2 crc32c clean (per frame)", v2, v2Clean));
+    report.add(runProcessReceived("processReceivedData v1 clean", v1, v1Clean));
+    report.add(runProcessReceived("processReceivedData v1 noisy", v1, v1Noisy));
+    report.add(runProcessReceived("processReceivedData v2 crc32c clean", v2, v2Clean));
+
+    // 指令编码（含校验）
+    uint8_t packet[MAX_COMMAND_SIZE];
+    report.add(bench::run("encodeCommand v1 xor", 5'000'000, [&](size_t i) {
+        encodeCommand(MOTOR_ID, static_cast<float>(i & 1023) * 1e-3f, packet);
+        bench::doNotOptimize(packet);
+    }));
+    CommandMessage command;
+    command.motorId = MOTOR_ID;
+    command.fields = protocol::CommandTorque::mask | protocol::CommandHostTime::mask;
+    ProtocolOptions v2Crc16 = v2;
+    v2Crc16.crc = CrcKind::CRC16;
+    report.add(bench::run("encodeCommand v2 crc16", 5'000'000, [&](size_t i) {
+        command.torque = static_cast<float>(i & 1023) * 1e-3f;
+        command.hostTimeNs = i;
+        bench::doNotOptimize(encodeCommand(command, v2Crc16, packet));
+    }));
+    report.add(bench::run("encodeCommand v2 crc32c", 5'000'000, [&](size_t i) {
+        command.torque = static_cast<float>(i & 1023) * 1e-3f;
+        command.hostTimeNs = i;
+        bench::doNotOptimize(encodeCommand(command, v2, packet));
+    }));
+
+    // 控制计算
+    PIDController pid(0.6f, 2.0f, 0.0005f, -0.9f, 0.9f, 0.5f);
+    report.add(bench::run("PIDController::compute", 5'000'000, [&](size_t i) {
+        const float t = static_cast<float>(i & 4095) * 0.01f;
+        bench::doNotOptimize(pid.compute(0.4f * std::sin(t), 0.35f * std::sin(t - 0.2f), 0.001f));
+    }));
+
+    // 电机查找
+    MotorManager& manager = MotorManager::getInstance();
+    for (int id = 1; id <= 8; ++id) {
+        manager.createMotor(id);
+    }
+    report.add(bench::run("MotorManager::getMotor (8 motors)", 10'000'000, [&](size_t i) {
+        bench::doNotOptimize(manager.getMotor(static_cast<int>(i & 7) + 1));
+    }));
+    report.add(bench::run("MotorManager::getMotor miss", 10'000'000, [&](size_t i) {
+        bench::doNotOptimize(manager.getMotor(static_cast<int>(i & 7) + 100));
+    }));
+
+    // 调试界面波形
+    runWaveform(report, 60.0f);
+    runWaveform(report, 1000.0f);
+
+    // 端到端
+    runLoopback(report);
+
+    const std::string path = bench::jsonPath(argc, argv);
+    if (!path.empty() && !report.writeJson(path)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,712 @@
+#include "bench.h"
+#include "include/PidController.h"
+#include "motor_manager.h"
+#include "packet_framer.h"
+#include "socket_compat.h"
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// 闭环长时间压测：N 个电机经 MotorManager 连接到回环仿真端（进程内或外部 TCP 仿真端），
+// 控制线程按固定频率读取反馈、计算 PID、下发力矩，周期性报告吞吐、往返时间分布、
+// 控制周期超时、校验错误、常驻内存与线程数，用于观察每电机两线程的架构随电机数增长在哪里失效。
+//
+//   motor_soak [--motors N] [--rate Hz] [--duration s] [--report s] [--protocol 1|2]
+//              [--port base] [--plant-threads K] [--external host] [--sweep] [--json path]
+//
+// 电机 i 连接 base + i 端口。--protocol 2（默认）时指令携带时间戳、仿真端回显，可直接统计往返时间；
+// --protocol 1 为 A0/A1 协议，只统计反馈在控制周期读到时的时延（反馈龄期）。
+// --sweep 从 1 个电机起按 2 倍递增到 N，每档运行 duration 秒，最后输出汇总表。Ctrl+C 提前结束当前档
+
+namespace {
+
+std::atomic<bool> interrupted{false};
+
+struct Options {
+    int motors = 8;
+    double rate = 1000.0;
+    double duration = 60.0;
+    double reportInterval = 10.0;
+    int protocol = 2;
+    int basePort = 17000;
+    int plantThreads = 0;        // 0 表示按硬件线程数的一半
+    std::string externalHost;    // 非空时不启动进程内仿真端
+    bool sweep = false;
+    std::string json;
+};
+
+void usage() {
+    std::cerr << "usage: motor_soak [--motors 1..255] [--rate Hz] [--duration s] [--report s] [--protocol 1|2]\n"
+                 "                  [--port base] [--plant-threads K] [--external host] [--sweep] [--json path]"
+              << std::endl;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--sweep") {
+            options.sweep = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            usage();
+            return false;
+        }
+        const std::string value = argv[++i];
+        try {
+            if (arg == "--motors") {
+                options.motors = std::stoi(value);
+            } else if (arg == "--rate") {
+                options.rate = std::stod(value);
+            } else if (arg == "--duration") {
+                options.duration = std::stod(value);
+            } else if (arg == "--report") {
+                options.reportInterval = std::stod(value);
+            } else if (arg == "--protocol") {
+                options.protocol = std::stoi(value);
+            } else if (arg == "--port") {
+                options.basePort = std::stoi(value);
+            } else if (arg == "--plant-threads") {
+                options.plantThreads = std::stoi(value);
+            } else if (arg == "--external") {
+                options.externalHost = value;
+            } else if (arg == "--json") {
+                options.json = value;
+            } else {
+                usage();
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "motor_soak: invalid value '" << value << "' for " << arg << std::endl;
+            return false;
+        }
+    }
+    if (options.motors < 1 || options.motors > 255 || options.rate <= 0.0 || options.duration <= 0.0 ||
+        options.reportInterval <= 0.0 || (options.protocol != 1 && options.protocol != 2) ||
+        options.basePort < 1 || options.basePort + options.motors > 65535) {
+        usage();
+        return false;
+    }
+    return true;
+}
+
+// 对数分桶直方图：每个 2 的幂区间分 16 档，相对误差不超过 1/16，内存固定，可长时间累计
+class LatencyHistogram {
+public:
+    void add(int64_t ns) {
+        const uint64_t value = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+        ++buckets_[index(value)];
+        ++count_;
+        max_ = std::max(max_, value);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            buckets_[i] += other.buckets_[i];
+        }
+        count_ += other.count_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    void clear() {
+        std::fill(std::begin(buckets_), std::end(buckets_), 0);
+        count_ = 0;
+        max_ = 0;
+    }
+
+    [[nodiscard]] uint64_t count() const { return count_; }
+
+    // 微秒，分位数取所在桶的上界
+    [[nodiscard]] bench::Percentiles percentiles() const {
+        return {at(0.50), at(0.99), at(0.999), static_cast<double>(max_) / 1000.0};
+    }
+
+private:
+    static constexpr size_t SUB = 16;
+    static constexpr size_t BUCKETS = 64 * SUB;
+
+    static size_t index(uint64_t value) {
+        if (value < SUB) {
+            return static_cast<size_t>(value);
+        }
+        const size_t exponent = static_cast<size_t>(std::bit_width(value)) - 1;
+        return (exponent - 3) * SUB + static_cast<size_t>((value >> (exponent - 4)) - SUB);
+    }
+
+    static uint64_t upperBound(size_t index) {
+        if (index < SUB) {
+            return index;
+        }
+        const size_t exponent = index / SUB + 3;
+        return ((SUB + index % SUB + 1) << (exponent - 4)) - 1;
+    }
+
+    [[nodiscard]] double at(double q) const {
+        if (count_ == 0) {
+            return 0.0;
+        }
+        const uint64_t rank = std::min<uint64_t>(count_ - 1, static_cast<uint64_t>(q * static_cast<double>(count_)));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += buckets_[i];
+            if (seen > rank) {
+                return static_cast<double>(std::min(upperBound(i), max_)) / 1000.0;
+            }
+        }
+        return static_cast<double>(max_) / 1000.0;
+    }
+
+    uint64_t buckets_[BUCKETS] = {};
+    uint64_t count_ = 0;
+    uint64_t max_ = 0;
+};
+
+// 进程内仿真端：每个工作线程用 poll 服务一组电机的监听与连接，
+// 每收到一条指令按 J dω/dt = τ - bω 积分一步并回一帧反馈（v1 为 A0 帧；v2 携带设备时间并回显指令时间戳）。
+// 仿真端本身不是每电机一线程，压测反映的是上位机一侧的扩展性
+class Plant {
+public:
+    ~Plant() { stop(); }
+
+    bool start(int motors, int basePort, int threads) {
+        running_ = true;
+        workers_.clear();
+        for (int i = 0; i < threads; ++i) {
+            workers_.push_back(std::make_unique<Worker>());
+        }
+        for (int id = 1; id <= motors; ++id) {
+            socket_t server = socket(AF_INET, SOCK_STREAM, 0);
+            int reuse = 1;
+            setsockopt(server, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(static_cast<uint16_t>(basePort + id));
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            if (bind(server, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(server, 4) != 0) {
+                std::cerr << "Plant: cannot listen on port " << basePort + id << std::endl;
+                closeSocket(server);
+                stop();
+                return false;
+            }
+            Worker& worker = *workers_[static_cast<size_t>(id) % workers_.size()];
+            worker.listeners.push_back({server, static_cast<uint8_t>(id)});
+        }
+        for (auto& worker : workers_) {
+            worker->thread = std::thread(&Plant::run, this, std::ref(*worker));
+        }
+        return true;
+    }
+
+    void stop() {
+        running_ = false;
+        for (auto& worker : workers_) {
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+            for (const auto& listener : worker->listeners) {
+                closeSocket(listener.sock);
+            }
+            for (const auto& connection : worker->connections) {
+                closeSocket(connection.sock);
+            }
+            worker->listeners.clear();
+            worker->connections.clear();
+        }
+    }
+
+    [[nodiscard]] uint64_t commands() const {
+        uint64_t total = 0;
+        for (const auto& worker : workers_) {
+            total += worker->commands.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    [[nodiscard]] uint64_t checksumErrors() const {
+        uint64_t total = 0;
+        for (const auto& worker : workers_) {
+            total += worker->checksumErrors.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    static constexpr float INERTIA = 0.01f;
+    static constexpr float DAMPING = 0.002f;
+    static constexpr size_t BUFFER_SIZE = 512;
+
+    struct Listener {
+        socket_t sock;
+        uint8_t motorId;
+    };
+
+    struct Connection {
+        socket_t sock;
+        uint8_t motorId;
+        uint8_t buffer[BUFFER_SIZE];
+        size_t size = 0;
+        float angle = 0.0f;
+        float omega = 0.0f;
+        int64_t lastNs = 0;
+    };
+
+    struct Worker {
+        std::vector<Listener> listeners;
+        std::vector<Connection> connections;
+        std::atomic<uint64_t> commands{0};
+        std::atomic<uint64_t> checksumErrors{0};
+        std::thread thread;
+    };
+
+    void run(Worker& worker) {
+        std::vector<pollfd_t> fds;
+        while (running_) {
+            fds.clear();
+            for (const auto& listener : worker.listeners) {
+                fds.push_back({listener.sock, POLLIN, 0});
+            }
+            for (const auto& connection : worker.connections) {
+                fds.push_back({connection.sock, POLLIN, 0});
+            }
+            if (pollSockets(fds.data(), fds.size(), 50) <= 0) {
+                continue;
+            }
+
+            const size_t listeners = worker.listeners.size();
+            for (size_t i = fds.size(); i-- > listeners;) {
+                if (fds[i].revents == 0) {
+                    continue;
+                }
+                Connection& connection = worker.connections[i - listeners];
+                const auto n = recv(connection.sock, reinterpret_cast<char*>(connection.buffer + connection.size),
+                                    BUFFER_SIZE - connection.size, 0);
+                if (n <= 0) {
+                    closeSocket(connection.sock);
+                    worker.connections.erase(worker.connections.begin() + static_cast<std::ptrdiff_t>(i - listeners));
+                    continue;
+                }
+                connection.size += static_cast<size_t>(n);
+                handle(worker, connection);
+            }
+
+            // 新连接放在最后处理，不打乱上面按下标对应的连接
+            for (size_t i = 0; i < listeners; ++i) {
+                if (fds[i].revents & POLLIN) {
+                    socket_t client = accept(worker.listeners[i].sock, nullptr, nullptr);
+                    if (client == INVALID_SOCKET_HANDLE) {
+                        continue;
+                    }
+                    int noDelay = 1;
+                    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+                    Connection connection{};
+                    connection.sock = client;
+                    connection.motorId = worker.listeners[i].motorId;
+                    worker.connections.push_back(connection);
+                }
+            }
+        }
+    }
+
+    // 逐帧解析缓冲区中的指令（v1 / v2 混合均可），不完整的尾部留到下一次
+    void handle(Worker& worker, Connection& connection) {
+        const uint8_t* data = connection.buffer;
+        size_t position = 0;
+        while (position < connection.size) {
+            const size_t remaining = connection.size - position;
+            if (data[position] == COMMAND_HEADER) {
+                if (remaining < COMMAND_PACKET_SIZE) {
+                    break;
+                }
+                if (xorChecksum(data + position, COMMAND_PACKET_SIZE - 1) != data[position + COMMAND_PACKET_SIZE - 1]) {
+                    worker.checksumErrors.fetch_add(1, std::memory_order_relaxed);
+                    ++position;
+                    continue;
+                }
+                CommandMessage command;
+                std::memcpy(&command.torque, data + position + 2, sizeof(float));
+                reply(worker, connection, command, nullptr);
+                position += COMMAND_PACKET_SIZE;
+            } else if (data[position] == protocol::V2_HEADER) {
+                CommandMessage command;
+                const int frame = protocol::decode<protocol::CommandLayout>(data + position, remaining, command);
+                if (frame == 0) {
+                    break;
+                }
+                if (frame < 0) {
+                    worker.checksumErrors.fetch_add(1, std::memory_order_relaxed);
+                    ++position;
+                    continue;
+                }
+                const CrcKind crc = (data[position + 1] & protocol::CRC32C_FLAG) ? CrcKind::CRC32C : CrcKind::CRC16;
+                reply(worker, connection, command, &crc);
+                position += static_cast<size_t>(frame);
+            } else {
+                ++position;
+            }
+        }
+        connection.size -= position;
+        std::memmove(connection.buffer, connection.buffer + position, connection.size);
+    }
+
+    // crc 为空表示 v1
+    static void reply(Worker& worker, Connection& connection, const CommandMessage& command, const CrcKind* crc) {
+        worker.commands.fetch_add(1, std::memory_order_relaxed);
+        const int64_t now = Motor::steadyNowNs();
+        const float dt = connection.lastNs > 0 ? std::min(static_cast<float>(now - connection.lastNs) * 1e-9f, 0.01f) : 0.0f;
+        connection.lastNs = now;
+        connection.omega += (command.torque - DAMPING * connection.omega) / INERTIA * dt;
+        connection.angle = std::fmod(connection.angle + connection.omega * dt * 57.2957795f + 360.0f, 360.0f);
+
+        FeedbackMessage feedback;
+        feedback.motorId = connection.motorId;
+        feedback.angle = connection.angle;
+        feedback.omega = connection.omega;
+        feedback.fields = protocol::FeedbackAngle::mask | protocol::FeedbackOmega::mask;
+        ProtocolOptions options;
+        if (crc) {
+            options.version = ProtocolVersion::V2;
+            options.crc = *crc;
+            feedback.fields |= protocol::FeedbackDeviceTime::mask;
+            feedback.deviceTimeUs = static_cast<uint32_t>(now / 1000);
+            if (command.fields & protocol::CommandHostTime::mask) {
+                feedback.fields |= protocol::FeedbackCommandTime::mask;
+                feedback.commandTimeNs = command.hostTimeNs;
+            }
+        }
+        uint8_t frame[MAX_FEEDBACK_SIZE];
+        const size_t size = encodeFeedback(feedback, options, frame);
+        send(connection.sock, reinterpret_cast<const char*>(frame), size, SOCKET_SEND_FLAGS);
+    }
+
+    std::atomic<bool> running_{false};
+    std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+// 进程资源：常驻内存（MB）与线程数，仅 Linux 从 /proc 读取，其他平台为 0
+struct ProcessUsage {
+    double rssMb = 0.0;
+    int threads = 0;
+};
+
+ProcessUsage processUsage() {
+    ProcessUsage usage;
+#ifdef __linux__
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key) {
+        if (key == "VmRSS:") {
+            double kb = 0.0;
+            status >> kb;
+            usage.rssMb = kb / 1024.0;
+        } else if (key == "Threads:") {
+            status >> usage.threads;
+        }
+        status.ignore(256, '\n');
+    }
+#endif
+    return usage;
+}
+
+struct Summary {
+    int motors = 0;
+    double seconds = 0.0;
+    double commandRate = 0.0;      // 仿真端收到的指令（包/秒），外部仿真端时为 0
+    double feedbackRate = 0.0;     // 上位机处理的反馈（包/秒）
+    bench::Percentiles rtt{};      // 往返时间（us），v1 无回显时为 0
+    uint64_t rttSamples = 0;
+    bench::Percentiles age{};      // 反馈龄期（us）
+    uint64_t ticks = 0;
+    uint64_t missedDeadlines = 0;
+    uint64_t checksumErrors = 0;   // 上位机 + 仿真端
+    int linksDown = 0;             // 结束时未处于 UP 的电机数
+    double rssStartMb = 0.0;
+    double rssEndMb = 0.0;
+    int threads = 0;
+};
+
+// 控制线程与报告线程共享的统计，控制线程每周期加锁一次
+struct Shared {
+    std::mutex mutex;
+    LatencyHistogram rtt;
+    LatencyHistogram age;
+    uint64_t ticks = 0;
+    uint64_t missed = 0;
+};
+
+void controlLoop(const std::vector<Motor*>& motors, double rate, std::atomic<bool>& running, Shared& shared) {
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate));
+    const float dt = static_cast<float>(1.0 / rate);
+
+    std::vector<PIDController> pids(motors.size(), PIDController(0.02f, 0.5f, 0.0f, -1.8f, 1.8f, 1.0f));
+    std::vector<uint64_t> lastSequence(motors.size(), 0);
+    LatencyHistogram rtt;
+    LatencyHistogram age;
+    auto next = Clock::now();
+    uint64_t tick = 0;
+
+    while (running) {
+        next += period;
+        const int64_t now = Motor::steadyNowNs();
+        const float t = static_cast<float>(tick) * dt;
+        for (size_t i = 0; i < motors.size(); ++i) {
+            const MotorState state = motors[i]->getState();
+            if (state.sequence != lastSequence[i]) {
+                lastSequence[i] = state.sequence;
+                age.add(now - state.receiveTimeNs);
+                if (state.commandTimeNs > 0) {
+                    rtt.add(state.receiveTimeNs - state.commandTimeNs);
+                }
+            }
+            // 各电机相位错开的速度正弦参考
+            const float reference = 10.0f * std::sin(2.0f * 3.14159265f * 0.5f * t + static_cast<float>(i));
+            motors[i]->setTorque(pids[i].compute(reference, state.omega, dt));
+        }
+        ++tick;
+
+        const bool late = Clock::now() > next;
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            shared.rtt.merge(rtt);
+            shared.age.merge(age);
+            ++shared.ticks;
+            shared.missed += late ? 1 : 0;
+        }
+        rtt.clear();
+        age.clear();
+
+        // 超时后从当前时刻重新对齐，不补跑错过的周期
+        if (late) {
+            next = Clock::now();
+        } else {
+            std::this_thread::sleep_until(next);
+        }
+    }
+}
+
+void printRow(double elapsed, int up, int motors, double commandRate, double feedbackRate,
+              const LatencyHistogram& rtt, const LatencyHistogram& age, uint64_t missed,
+              uint64_t checksumErrors, const ProcessUsage& usage, double rssStart) {
+    std::printf("[%7.0fs] up %3d/%-3d cmd %9.0f/s fb %9.0f/s", elapsed, up, motors, commandRate, feedbackRate);
+    if (rtt.count() > 0) {
+        const bench::Percentiles p = rtt.percentiles();
+        std::printf("  rtt p50 %7.1f p99 %7.1f p99.9 %7.1f max %8.1f us", p.p50, p.p99, p.p999, p.max);
+    }
+    const bench::Percentiles a = age.percentiles();
+    std::printf("  age p99 %7.1f us  missed %6llu  crc %4llu  rss %6.1f MB (%+.1f)  threads %4d\n",
+                a.p99, static_cast<unsigned long long>(missed), static_cast<unsigned long long>(checksumErrors),
+                usage.rssMb, usage.rssMb - rssStart, usage.threads);
+    std::fflush(stdout);
+}
+
+Summary runSoak(const Options& options, int motorCount) {
+    Summary summary;
+    summary.motors = motorCount;
+    summary.rssStartMb = processUsage().rssMb;
+
+    Plant plant;
+    const bool external = !options.externalHost.empty();
+    if (!external) {
+        const int threads = options.plantThreads > 0
+            ? options.plantThreads
+            : std::max(1, static_cast<int>(std::thread::hardware_concurrency()) / 2);
+        if (!plant.start(motorCount, options.basePort, std::min(threads, motorCount))) {
+            return summary;
+        }
+    }
+
+    MotorManager& manager = MotorManager::getInstance();
+    ProtocolOptions protocol;
+    if (options.protocol == 2) {
+        protocol.version = ProtocolVersion::V2;
+        protocol.crc = CrcKind::CRC32C;
+        protocol.commandTimestamp = true;
+    }
+    std::vector<Motor*> motors;
+    for (int id = 1; id <= motorCount; ++id) {
+        Motor* motor = manager.createMotor(id);
+        motor->setProtocol(protocol);
+        motors.push_back(motor);
+    }
+    if (!manager.connectAll(external ? options.externalHost : "127.0.0.1", options.basePort)) {
+        std::cerr << "motor_soak: not all motors connected, continuing with the rest" << std::endl;
+    }
+
+    Shared shared;
+    std::atomic<bool> running{true};
+    std::thread control(controlLoop, std::cref(motors), options.rate, std::ref(running), std::ref(shared));
+
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    auto lastReport = start;
+    uint64_t lastCommands = 0;
+    uint64_t lastFeedback = 0;
+    LatencyHistogram totalRtt;
+    LatencyHistogram totalAge;
+    uint64_t totalMissed = 0;
+    uint64_t totalTicks = 0;
+
+    auto feedbackCount = [&]() {
+        uint64_t total = 0;
+        for (Motor* motor : motors) {
+            total += motor->getState().sequence;
+        }
+        return total;
+    };
+    auto checksumErrors = [&]() {
+        uint64_t total = plant.checksumErrors();
+        for (Motor* motor : motors) {
+            total += motor->getLinkStats().checksumErrors;
+        }
+        return total;
+    };
+
+    bool done = false;
+    while (!done) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        const auto now = Clock::now();
+        const double elapsed = std::chrono::duration<double>(now - start).count();
+        done = elapsed >= options.duration || interrupted;
+        const double interval = std::chrono::duration<double>(now - lastReport).count();
+        if (interval < options.reportInterval && !done) {
+            continue;
+        }
+
+        LatencyHistogram rtt;
+        LatencyHistogram age;
+        uint64_t missed;
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            rtt = shared.rtt;
+            age = shared.age;
+            missed = shared.missed;
+            totalTicks += shared.ticks;
+            shared.rtt.clear();
+            shared.age.clear();
+            shared.missed = 0;
+            shared.ticks = 0;
+        }
+        totalRtt.merge(rtt);
+        totalAge.merge(age);
+        totalMissed += missed;
+
+        const uint64_t commands = plant.commands();
+        const uint64_t feedback = feedbackCount();
+        int up = 0;
+        for (Motor* motor : motors) {
+            up += motor->getLinkState() == LinkState::UP ? 1 : 0;
+        }
+        printRow(elapsed, up, motorCount, static_cast<double>(commands - lastCommands) / interval,
+                 static_cast<double>(feedback - lastFeedback) / interval, rtt, age, missed, checksumErrors(),
+                 processUsage(), summary.rssStartMb);
+        lastCommands = commands;
+        lastFeedback = feedback;
+        lastReport = now;
+
+        if (done) {
+            summary.seconds = elapsed;
+            summary.commandRate = static_cast<double>(commands) / elapsed;
+            summary.feedbackRate = static_cast<double>(feedback) / elapsed;
+            summary.linksDown = motorCount - up;
+        }
+    }
+
+    running = false;
+    control.join();
+
+    summary.rtt = totalRtt.percentiles();
+    summary.rttSamples = totalRtt.count();
+    summary.age = totalAge.percentiles();
+    summary.ticks = totalTicks;
+    summary.missedDeadlines = totalMissed;
+    summary.checksumErrors = checksumErrors();
+    const ProcessUsage usage = processUsage();
+    summary.rssEndMb = usage.rssMb;
+    summary.threads = usage.threads;
+
+    for (int id = 1; id <= motorCount; ++id) {
+        manager.removeMotor(id);
+    }
+    plant.stop();
+    return summary;
+}
+
+void printSummary(const std::vector<Summary>& summaries) {
+    std::printf("\n%6s %8s %11s %11s %9s %9s %9s %9s %9s %9s %6s %8s %7s\n",
+                "motors", "seconds", "cmd/s", "fb/s", "rtt p50", "rtt p99", "p99.9", "rtt max", "age p99",
+                "missed", "crc", "rss +MB", "threads");
+    for (const Summary& s : summaries) {
+        std::printf("%6d %8.0f %11.0f %11.0f %9.1f %9.1f %9.1f %9.1f %9.1f %9llu %6llu %8.1f %7d\n",
+                    s.motors, s.seconds, s.commandRate, s.feedbackRate, s.rtt.p50, s.rtt.p99, s.rtt.p999,
+                    s.rtt.max, s.age.p99, static_cast<unsigned long long>(s.missedDeadlines),
+                    static_cast<unsigned long long>(s.checksumErrors), s.rssEndMb - s.rssStartMb, s.threads);
+    }
+}
+
+bool writeJson(const std::string& path, const Options& options, const std::vector<Summary>& summaries) {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        std::cerr << "motor_soak: cannot write " << path << std::endl;
+        return false;
+    }
+    std::fprintf(file, "{\n  \"rate\": %.1f,\n  \"protocol\": %d,\n  \"runs\": [", options.rate, options.protocol);
+    for (size_t i = 0; i < summaries.size(); ++i) {
+        const Summary& s = summaries[i];
+        std::fprintf(file,
+                     "%s\n    {\"motors\": %d, \"seconds\": %.1f, \"command_rate\": %.1f, \"feedback_rate\": %.1f, "
+                     "\"rtt_us\": {\"samples\": %llu, \"p50\": %.2f, \"p99\": %.2f, \"p999\": %.2f, \"max\": %.2f}, "
+                     "\"feedback_age_us\": {\"p50\": %.2f, \"p99\": %.2f, \"p999\": %.2f, \"max\": %.2f}, "
+                     "\"ticks\": %llu, \"missed_deadlines\": %llu, \"checksum_errors\": %llu, \"links_down\": %d, "
+                     "\"rss_start_mb\": %.2f, \"rss_end_mb\": %.2f, \"threads\": %d}",
+                     i == 0 ? "" : ",", s.motors, s.seconds, s.commandRate, s.feedbackRate,
+                     static_cast<unsigned long long>(s.rttSamples), s.rtt.p50, s.rtt.p99, s.rtt.p999, s.rtt.max,
+                     s.age.p50, s.age.p99, s.age.p999, s.age.max, static_cast<unsigned long long>(s.ticks),
+                     static_cast<unsigned long long>(s.missedDeadlines),
+                     static_cast<unsigned long long>(s.checksumErrors), s.linksDown, s.rssStartMb, s.rssEndMb,
+                     s.threads);
+    }
+    std::fprintf(file, "\n  ]\n}\n");
+    return std::fclose(file) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    initializeSockets();
+    std::signal(SIGINT, [](int) { interrupted = true; });
+
+    std::vector<int> counts;
+    if (options.sweep) {
+        for (int n = 1; n < options.motors; n *= 2) {
+            counts.push_back(n);
+        }
+    }
+    counts.push_back(options.motors);
+
+    std::vector<Summary> summaries;
+    for (int count : counts) {
+        if (interrupted) {
+            break;
+        }
+        std::printf("\n== %d motor(s), control %.0f Hz, protocol v%d, %.0f s ==\n",
+                    count, options.rate, options.protocol, options.duration);
+        summaries.push_back(runSoak(options, count));
+    }
+
+    printSummary(summaries);
+    if (!options.json.empty() && !writeJson(options.json, options, summaries)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include "bench.h"
+#include "include/MpcController.h"
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+// MPC 求解耗时与预测步数的关系：闭环仿真 GM6020 模型（含库仑摩擦与力矩饱和），
+// 参考为大角度阶跃与正弦跟踪交替，逐次记录 compute 的耗时分布、ADMM 迭代次数与跟踪误差
+
+namespace {
+
+constexpr float DT = 0.01f;
+constexpr int SUBSTEPS = 10;
+constexpr size_t TICKS = 20'000;
+constexpr double PI = 3.14159265358979323846;
+
+struct Plant {
+    double position = 0.0;
+    double omega = 0.0;
+
+    void step(float torque) {
+        const double h = DT / SUBSTEPS;
+        for (int i = 0; i < SUBSTEPS; ++i) {
+            const double friction = omega > 0.0 ? 0.02 : (omega < 0.0 ? -0.02 : 0.0);
+            omega += (torque - friction - 0.002 * omega) / 0.01 * h;
+            position += omega * h;
+        }
+    }
+};
+
+// 每 2 秒切换一次：±2 rad 阶跃 / 1 Hz、幅值 1 rad 的正弦；返回位置与速度参考
+struct Reference {
+    double position;
+    double velocity;
+};
+
+Reference reference(double t) {
+    const int phase = static_cast<int>(t / 2.0) % 4;
+    if (phase % 2 == 0) {
+        return {phase == 0 ? 2.0 : -2.0, 0.0};
+    }
+    return {std::sin(2.0 * PI * t), 2.0 * PI * std::cos(2.0 * PI * t)};
+}
+
+void runHorizon(size_t horizon) {
+    MpcConfig config;
+    config.horizon = horizon;
+    config.dt = DT;
+
+    MpcController mpc;
+    bench::Result setup = bench::run("", 2'000, [&](size_t) {
+        bench::doNotOptimize(mpc.setConfig(config));
+    });
+
+    Plant plant;
+    std::vector<double> latencies;
+    latencies.reserve(TICKS);
+    double iterations = 0.0;
+    size_t unconverged = 0;
+    double squaredError = 0.0;
+    float positionRef[MpcController::MAX_HORIZON];
+    float velocityRef[MpcController::MAX_HORIZON];
+    for (size_t tick = 0; tick < TICKS; ++tick) {
+        const double t = static_cast<double>(tick) * DT;
+        for (size_t k = 0; k < horizon; ++k) {
+            const Reference ahead = reference(t + static_cast<double>(k + 1) * DT);
+            positionRef[k] = static_cast<float>(ahead.position - plant.position);
+            velocityRef[k] = static_cast<float>(ahead.velocity);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const float torque = mpc.compute(0.0f, static_cast<float>(plant.omega), positionRef, velocityRef);
+        const auto end = std::chrono::steady_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+
+        iterations += mpc.stats().iterations;
+        unconverged += mpc.stats().converged ? 0 : 1;
+        plant.step(torque);
+        const double error = reference(t + DT).position - plant.position;
+        squaredError += error * error;
+    }
+
+    const bench::Percentiles p = bench::percentiles(latencies);
+    std::printf("%7zu %10.1f %8.2f %8.2f %8.2f %8.2f %8.1f %7zu %10.4f\n",
+                horizon, setup.nsPerOp / 1000.0, p.p50, p.p99, p.p999, p.max,
+                iterations / TICKS, unconverged, std::sqrt(squaredError / TICKS));
+}
+
+} // namespace
+
+int main() {
+    std::printf("%zu closed-loop ticks per horizon, solve time in us\n", TICKS);
+    std::printf("%7s %10s %8s %8s %8s %8s %8s %7s %10s\n",
+                "horizon", "setup", "p50", "p99", "p99.9", "max", "iters", "capped", "rms (rad)");
+    for (size_t horizon : {5, 10, 15, 20, 25, 30}) {
+        runHorizon(horizon);
+    }
+    return 0;
+}
@@ -0,0 +1,236 @@
+#include "bench.h"
+#include "packet_framer.h"
+#include "shm_transport.h"
+#include "socket_compat.h"
+#include "tcp_transport.h"
+#include "udp_transport.h"
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+// 回环往返延时：客户端连续发送两条 7 字节指令（模拟发送线程与控制节拍错位时的排队），
+// 仿真端收齐后回一条 11 字节反馈，客户端计时到收齐反馈为止。
+// 两次小包连续写正是 Nagle 与延迟 ACK 相互等待的典型场景。
+// 共享内存传输层以同样方式计时，仿真端为另一线程上的 ShmTransport（设备端）
+
+namespace {
+
+constexpr int ITERATIONS = 2000;
+constexpr int BASE_PORT = 16000;
+
+void makeFeedback(uint8_t* out) {
+    out[0] = FEEDBACK_HEADER;
+    out[1] = 0;
+    std::memset(out + 2, 0, 8);
+    out[FEEDBACK_PACKET_SIZE - 1] = xorChecksum(out, FEEDBACK_PACKET_SIZE - 1);
+}
+
+socket_t listenOn(int port, int type) {
+    socket_t server = socket(AF_INET, type, 0);
+    int reuse = 1;
+    setsockopt(server, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(server, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    if (type == SOCK_STREAM) {
+        listen(server, 1);
+    }
+    return server;
+}
+
+// TCP 仿真端：默认 socket 选项（与 Unity TcpClient 默认一致，Nagle 开启）
+void tcpPlant(socket_t server) {
+    socket_t client = accept(server, nullptr, nullptr);
+    uint8_t buffer[64];
+    uint8_t feedback[FEEDBACK_PACKET_SIZE];
+    makeFeedback(feedback);
+    size_t pending = 0;
+    while (true) {
+        const auto n = recv(client, reinterpret_cast<char*>(buffer), sizeof(buffer), 0);
+        if (n <= 0) {
+            break;
+        }
+        pending += static_cast<size_t>(n);
+        while (pending >= 2 * COMMAND_PACKET_SIZE) {
+            pending -= 2 * COMMAND_PACKET_SIZE;
+            send(client, reinterpret_cast<const char*>(feedback), FEEDBACK_PACKET_SIZE, SOCKET_SEND_FLAGS);
+        }
+    }
+    closeSocket(client);
+    closeSocket(server);
+}
+
+void udpPlant(socket_t server, std::atomic<bool>& running) {
+    uint8_t buffer[64];
+    uint8_t reply[UdpTransport::SEQUENCE_SIZE + FEEDBACK_PACKET_SIZE];
+    makeFeedback(reply + UdpTransport::SEQUENCE_SIZE);
+    uint32_t sequence = 0;
+    int pending = 0;
+    pollfd_t pfd{};
+    pfd.fd = server;
+    pfd.events = POLLIN;
+    while (running) {
+        if (pollSockets(&pfd, 1, 50) <= 0) {
+            continue;
+        }
+        sockaddr_in peer{};
+        socklen_t peerLength = sizeof(peer);
+        const auto n = recvfrom(server, reinterpret_cast<char*>(buffer), sizeof(buffer), 0,
+                                reinterpret_cast<sockaddr*>(&peer), &peerLength);
+        if (n <= 0 || ++pending < 2) {
+            continue;
+        }
+        pending = 0;
+        std::memcpy(reply, &sequence, sizeof(sequence));
+        ++sequence;
+        sendto(server, reinterpret_cast<const char*>(reply), sizeof(reply), 0,
+               reinterpret_cast<sockaddr*>(&peer), peerLength);
+    }
+    closeSocket(server);
+}
+
+// 共享内存仿真端：传输层已由调用方打开，上位机关闭后 receive 返回 -1
+void shmPlant(ShmTransport& transport) {
+    uint8_t buffer[64];
+    uint8_t feedback[FEEDBACK_PACKET_SIZE];
+    makeFeedback(feedback);
+    size_t pending = 0;
+    while (true) {
+        const int n = transport.receive(buffer, sizeof(buffer), 1000);
+        if (n < 0) {
+            break;
+        }
+        pending += static_cast<size_t>(n);
+        while (pending >= 2 * COMMAND_PACKET_SIZE) {
+            pending -= 2 * COMMAND_PACKET_SIZE;
+            transport.send(feedback, FEEDBACK_PACKET_SIZE);
+        }
+    }
+}
+
+bench::Percentiles roundTrips(Transport& transport) {
+    uint8_t command[COMMAND_PACKET_SIZE];
+    encodeCommand(0, 0.0f, command);
+    uint8_t buffer[64];
+    std::vector<double> samples;
+    samples.reserve(ITERATIONS);
+
+    for (int i = 0; i < ITERATIONS; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        transport.send(command, COMMAND_PACKET_SIZE);
+        transport.send(command, COMMAND_PACKET_SIZE);
+        size_t received = 0;
+        while (received < FEEDBACK_PACKET_SIZE) {
+            const int n = transport.receive(buffer, sizeof(buffer), 1000);
+            if (n < 0) {
+                return bench::percentiles(samples);
+            }
+            received += static_cast<size_t>(n);
+        }
+        samples.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    return bench::percentiles(samples);
+}
+
+void report(const char* name, const bench::Percentiles& p) {
+    std::printf("%-32s p50 %9.1f us  p99 %9.1f us  p99.9 %9.1f us  max %9.1f us\n",
+                name, p.p50, p.p99, p.p999, p.max);
+}
+
+void runTcp(const char* name, int port, const TransportOptions& options) {
+    socket_t server = listenOn(port, SOCK_STREAM);
+    std::thread plant(tcpPlant, server);
+    {
+        TcpTransport transport("127.0.0.1", port, options);
+        if (transport.open()) {
+            report(name, roundTrips(transport));
+        }
+    }
+    plant.join();
+}
+
+void runUdp(const char* name, int port, const TransportOptions& options) {
+    std::atomic<bool> running{true};
+    socket_t server = listenOn(port, SOCK_DGRAM);
+    std::thread plant(udpPlant, server, std::ref(running));
+    {
+        UdpTransport transport("127.0.0.1", port, options);
+        if (transport.open()) {
+            report(name, roundTrips(transport));
+        }
+    }
+    running = false;
+    plant.join();
+}
+
+void runShm(const char* name, const ShmTransport::Options& options) {
+    const std::string segment = "controlry-transport-bench";
+    ShmTransport::Options deviceOptions = options;
+    deviceOptions.role = ShmTransport::Role::DEVICE;
+    // 仿真端先打开（创建共享内存段），上位机此后发出的指令不会因对方未连上而被丢弃
+    ShmTransport device(segment, deviceOptions);
+    if (!device.open()) {
+        return;
+    }
+    std::thread plant(shmPlant, std::ref(device));
+    {
+        ShmTransport transport(segment, options);
+        if (transport.open()) {
+            report(name, roundTrips(transport));
+        }
+    }
+    plant.join();
+}
+
+} // namespace
+
+int main() {
+    initializeSockets();
+    int port = BASE_PORT;
+
+    TransportOptions nagle;
+    nagle.tcpNoDelay = false;
+    runTcp("tcp (Nagle on)", port++, nagle);
+
+    TransportOptions noDelay;
+    runTcp("tcp nodelay", port++, noDelay);
+
+    TransportOptions quickAck;
+    quickAck.quickAck = true;
+    runTcp("tcp nodelay+quickack", port++, quickAck);
+
+    TransportOptions smallBuffers;
+    smallBuffers.sendBufferSize = 4096;
+    smallBuffers.receiveBufferSize = 4096;
+    runTcp("tcp nodelay+4k buffers", port++, smallBuffers);
+
+    TransportOptions busyPoll;
+    busyPoll.busyPollUs = 50;
+    runTcp("tcp nodelay+busypoll 50us", port++, busyPoll);
+
+    TransportOptions nonBlocking;
+    nonBlocking.nonBlocking = true;
+    runTcp("tcp nodelay+nonblocking", port++, nonBlocking);
+
+    TransportOptions priority;
+    priority.priority = 6;
+    runTcp("tcp nodelay+priority 6", port++, priority);
+
+    runUdp("udp", port++, TransportOptions{});
+
+    runShm("shm futex", ShmTransport::Options{});
+
+    // 自旋时两端各占一个核，单核机器上自旋方会挡住对方，反而更慢
+    if (std::thread::hardware_concurrency() >= 2) {
+        ShmTransport::Options spin;
+        spin.spinUs = 50;
+        runShm("shm spin 50us", spin);
+
+        ShmTransport::Options busyPoll;
+        busyPoll.busyPoll = true;
+        runShm("shm busypoll", busyPoll);
+    }
+    return 0;
+}
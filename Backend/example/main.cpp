@@ -1,7 +1,10 @@
 #include <iostream>
 #include "motor_manager.h"
+#include "profiler.h"
 #include "include/MotorControl.h"
+#ifndef CONTROLRY_HEADLESS
 #include "include/debug.h"
+#endif
 
 int main() {
     MotorManager& motorManager = MotorManager::getInstance();
@@ -27,16 +30,25 @@ int main() {
         }
     }
 
+    // 运行时剖析：curl http://127.0.0.1:9100/metrics，/trace/start 后访问 /trace 得到 Chrome trace
+    profiler::MetricsServer metrics;
+    metrics.start(9100);
+
     std::thread controlThread;
     startTorqueControl(controlThread);
     std::cout << "All motors connected. Press Enter to exit..." << std::endl;
+#ifndef CONTROLRY_HEADLESS
     startDebugThread();
+#endif
 
     std::cin.get();
 
+#ifndef CONTROLRY_HEADLESS
     stopDebugThread();
+#endif
     stopTorqueControl(controlThread);
     motorManager.disconnectAll();
+    metrics.stop();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef ANGLE_TRACKER_H
+#define ANGLE_TRACKER_H
+
+#include <cmath>
+#include <cstdint>
+
+// 角度工具（单位：度），输入可以是任意圈数的角度
+namespace angle {
+
+// 归一化到 [-180, 180)
+inline float wrap180(double deg) {
+    return static_cast<float>(deg - 360.0 * std::floor((deg + 180.0) / 360.0));
+}
+
+// 归一化到 [0, 360)
+inline float wrap360(double deg) {
+    const float wrapped = static_cast<float>(deg - 360.0 * std::floor(deg / 360.0));
+    return wrapped < 360.0f ? wrapped : 0.0f;
+}
+
+// 从 fromDeg 转到 toDeg 的最短路径角度差，位于 [-180, 180)；角度环误差直接用它
+inline float shortestDelta(double fromDeg, double toDeg) {
+    return wrap180(toDeg - fromDeg);
+}
+
+// 与 positionDeg 最近的、和 targetDeg 同一物理角度的多圈位置
+inline double nearestTarget(double targetDeg, double positionDeg) {
+    return positionDeg + shortestDelta(positionDeg, targetDeg);
+}
+
+} // namespace angle
+
+// 由回绕角度维护多圈位置：圈数为 64 位整数，圈内角度直接取自测量值，累计多少圈都不会损失精度。
+// 相邻两次测量之间转过不足半圈即可正确计圈（1 kHz 反馈下对应 180000°/s）
+class AngleTracker {
+public:
+    AngleTracker();
+
+    // 输入设备上报的角度（度，回绕范围任意，如模拟器的 ±360°），返回展开后的位置（度）
+    double update(float wrappedDeg);
+    // 清除历史，下一次 update 从测量值所在的圈开始
+    void reset();
+
+    [[nodiscard]] double position() const;
+    [[nodiscard]] int64_t turns() const;        // 向下取整的圈数，-10° 记为 -1 圈 350°
+    [[nodiscard]] float angleInTurn() const;    // [0, 360)
+    [[nodiscard]] bool initialized() const;
+
+private:
+    bool hasSample;
+    int64_t turnCount;
+    float withinTurn;
+};
+
+#endif // ANGLE_TRACKER_H
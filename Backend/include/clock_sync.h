@@ -0,0 +1,73 @@
+#ifndef CLOCK_SYNC_H
+#define CLOCK_SYNC_H
+
+#include <cstddef>
+#include <cstdint>
+
+// 上位机与设备之间的时钟同步（NTP 思路）：
+//   带指令时间戳回显时，每个样本给出 t0（指令发出，上位机）、td（反馈发出，设备）、t1（反馈到达，上位机），
+//   offset = (t0 + t1) / 2 - td，误差不超过往返时间的一半；
+//   无回显时退化为单向，offset = t1 - td 的下包络，包含最小单向时延。
+// 每个窗口内只取往返（或单向时延）最小的样本作为同步点，再对同步点做带遗忘的直线拟合，
+// 得到偏移与频率漂移。只应由一个线程（接收线程）更新
+class ClockSync {
+public:
+    struct Options {
+        size_t window = 32;        // 每个同步点取自多少个样本
+        double forgetting = 0.98;  // 同步点拟合的遗忘因子
+        double minDriftSpan = 2.0; // 同步点覆盖的时间跨度（秒）达到后才估计漂移
+    };
+
+    struct Estimate {
+        bool synchronized = false;
+        double offsetNs = 0.0;     // 上位机时间 - 设备时间（最近同步点处）
+        double driftPpm = 0.0;     // 设备时钟相对上位机的频率偏差，正值表示设备时钟偏快
+        double rttNs = 0.0;        // 最近同步点的往返时间，单向模式下为 0
+        uint64_t syncPoints = 0;
+    };
+
+    ClockSync();
+    explicit ClockSync(const Options& options);
+
+    // hostSendNs < 0 表示没有指令时间戳回显；返回 true 表示产生了新的同步点
+    bool addSample(int64_t hostSendNs, uint32_t deviceTimeUs, int64_t hostReceiveNs);
+
+    // 设备时间（32 位微秒，按最近样本展开回绕）换算为上位机 steady_clock 纳秒，未同步时返回 -1
+    [[nodiscard]] int64_t toHost(uint32_t deviceTimeUs) const;
+
+    [[nodiscard]] const Estimate& estimate() const;
+    void reset();
+
+private:
+    int64_t unwrap(uint32_t deviceTimeUs) const;
+    void addSyncPoint(double deviceNs, double offsetNs, double rttNs);
+    [[nodiscard]] double offsetAt(double deviceNs) const;
+
+    Options options;
+    Estimate current;
+
+    // 设备时间展开
+    bool hasDeviceTime;
+    uint32_t lastDeviceUs;
+    int64_t deviceEpochUs;
+
+    // 当前窗口内的最佳样本
+    size_t windowCount;
+    double bestDelay;
+    double bestDeviceNs;
+    double bestOffsetNs;
+    double bestRttNs;
+
+    // 同步点直线拟合：offset = a + b * (device - reference)，x 以秒计以保证数值条件
+    double referenceDeviceNs;
+    double referenceOffsetNs;
+    double sumW;
+    double sumX;
+    double sumY;
+    double sumXX;
+    double sumXY;
+    double interceptNs;
+    double slope;
+};
+
+#endif // CLOCK_SYNC_H
@@ -0,0 +1,69 @@
+#ifndef CONNECTION_SUPERVISOR_H
+#define CONNECTION_SUPERVISOR_H
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "motor.h"
+
+// 连接监管：周期检查各电机的反馈新鲜度，链路断开或反馈超时后
+// 以带抖动的指数退避并行重连，期间保持零力矩输出，并发布 LinkState。
+// 用户主动 Motor::disconnect() 的电机保持 DISCONNECTED，不会被重连
+class ConnectionSupervisor {
+public:
+    struct Config {
+        std::chrono::milliseconds feedbackTimeout{200};  // 超过该时间无反馈视为链路失效
+        std::chrono::milliseconds initialBackoff{50};
+        std::chrono::milliseconds maxBackoff{2000};
+        float jitter = 0.3f;                              // 退避时间的随机扰动比例，避免多个电机同时重连
+        std::chrono::milliseconds period{5};              // 监管线程检查周期
+    };
+
+    ConnectionSupervisor();
+    ~ConnectionSupervisor();
+
+    ConnectionSupervisor(const ConnectionSupervisor&) = delete;
+    ConnectionSupervisor& operator=(const ConnectionSupervisor&) = delete;
+
+    // 加入 / 移出监管，移出时等待进行中的重连结束
+    void watch(Motor* motor);
+    void unwatch(int motorId);
+
+    void start();
+    void start(const Config& config);
+    void stop();
+    [[nodiscard]] bool isRunning() const;
+
+    // 成功重连次数
+    [[nodiscard]] uint64_t reconnects() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        Motor* motor = nullptr;
+        int attempts = 0;
+        Clock::time_point nextAttempt{};
+        int64_t connectedNs = 0;  // 最近一次连接建立的时刻，之后的反馈才算新鲜
+        std::future<bool> pending;
+    };
+
+    void run();
+    void supervise(Entry& entry, Clock::time_point now);
+    void launchReconnect(Entry& entry);
+    std::chrono::milliseconds backoff(int attempts);
+
+    Config config;
+    std::vector<Entry> entries;
+    std::mutex mutex;
+    std::thread thread;
+    std::atomic<bool> running;
+    std::atomic<uint64_t> reconnectCount;
+    std::mt19937 rng;
+};
+
+#endif // CONNECTION_SUPERVISOR_H
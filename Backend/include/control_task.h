@@ -0,0 +1,228 @@
+#ifndef CONTROL_TASK_H
+#define CONTROL_TASK_H
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+class ControlScheduler;
+
+// 运行在控制线程上的协程任务。任务函数返回 ControlTask，用 co_await 等待下一个控制周期、
+// 定时或条件，也可以 co_await 另一个 ControlTask 作为子序列。
+// 任务在挂起处让出控制线程，不占用线程，也不阻塞：成千上万个任务共享一个控制周期。
+// 任务中只能 co_await control:: 下的等待体或其他 ControlTask
+class ControlTask {
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    // 根任务的挂起原因，由等待体写入，调度器据此判断是否就绪
+    enum class Wait : uint8_t {
+        START,      // 刚加入调度器，尚未运行
+        TICK,       // 下一个控制周期
+        TIME,       // 到达 wakeNs
+        CONDITION   // 条件成立，或到达 wakeNs 超时
+    };
+
+    // 子任务结束后直接切回等待它的父任务（对称转移），根任务结束后挂起等调度器回收
+    struct FinalAwaiter {
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(Handle handle) const noexcept {
+            const std::coroutine_handle<> continuation = handle.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type {
+        promise_type* root = this;              // 所在任务树的根
+        std::coroutine_handle<> continuation;   // 等待本任务的父任务
+        std::exception_ptr error;
+
+        // 以下仅根任务使用
+        ControlScheduler* scheduler = nullptr;
+        std::coroutine_handle<> leaf;           // 调度器实际恢复的协程（最内层子任务）
+        Wait wait = Wait::START;
+        int64_t wakeNs = 0;
+        bool (*condition)(void*) = nullptr;     // 条件等待：谓词保存在挂起中的等待体里，不分配内存
+        void* conditionContext = nullptr;
+        bool conditionMet = false;
+
+        ControlTask get_return_object() noexcept {
+            return ControlTask(Handle::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+    };
+
+    // co_await 子任务：子任务立即在当前周期开始执行，完成后回到父任务；子任务的异常在父任务中重新抛出
+    struct Awaiter {
+        Handle child;
+
+        [[nodiscard]] bool await_ready() const noexcept { return !child || child.done(); }
+        std::coroutine_handle<> await_suspend(Handle parent) const noexcept {
+            child.promise().root = parent.promise().root;
+            child.promise().continuation = parent;
+            return child;
+        }
+        void await_resume() const {
+            if (child && child.promise().error) {
+                std::rethrow_exception(child.promise().error);
+            }
+        }
+    };
+
+    ControlTask() = default;
+    ControlTask(ControlTask&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    ControlTask& operator=(ControlTask&& other) noexcept {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    ControlTask(const ControlTask&) = delete;
+    ControlTask& operator=(const ControlTask&) = delete;
+    ~ControlTask() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    [[nodiscard]] bool valid() const noexcept { return static_cast<bool>(handle); }
+    Awaiter operator co_await() && noexcept { return Awaiter{handle}; }
+
+private:
+    explicit ControlTask(Handle handle) : handle(handle) {}
+
+    Handle handle;
+
+    friend class ControlScheduler;
+};
+
+// 协程调度器：控制线程每个周期调用一次 tick，按加入顺序恢复就绪的任务。
+// spawn / cancel 可以在任意线程（包括任务内部）调用，在下一次 tick 开始时生效
+class ControlScheduler {
+public:
+    using TaskId = uint64_t;
+
+    ControlScheduler();
+    ~ControlScheduler();
+    ControlScheduler(const ControlScheduler&) = delete;
+    ControlScheduler& operator=(const ControlScheduler&) = delete;
+
+    // 返回任务编号，无效任务返回 0
+    TaskId spawn(ControlTask task);
+    void cancel(TaskId id);
+    void cancelAll();
+
+    // nowNs 为本周期的时刻（steady_clock 纳秒），sleep / 超时均以此计时
+    void tick(int64_t nowNs);
+
+    [[nodiscard]] int64_t now() const;
+    [[nodiscard]] uint64_t ticks() const;
+    // 运行中与等待开始的任务数
+    [[nodiscard]] size_t size() const;
+
+private:
+    struct Entry {
+        TaskId id;
+        ControlTask::Handle handle;
+    };
+
+    static bool ready(ControlTask::promise_type& promise, int64_t nowNs);
+    void adoptPending();
+    void finish(const Entry& entry);
+
+    std::vector<Entry> tasks;
+    int64_t nowNs;
+    uint64_t tickCount;
+
+    std::mutex pendingMutex;
+    std::vector<Entry> pending;
+    std::vector<TaskId> cancelled;
+    bool cancelAllRequested;
+    std::atomic<bool> hasPending;
+    std::atomic<TaskId> nextId;
+    std::atomic<size_t> count;
+};
+
+// 任务内可用的等待体
+namespace control {
+
+// 等待下一个控制周期
+struct NextTick {
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+    void await_suspend(ControlTask::Handle handle) const noexcept {
+        ControlTask::promise_type& root = *handle.promise().root;
+        root.leaf = handle;
+        root.wait = ControlTask::Wait::TICK;
+    }
+    void await_resume() const noexcept {}
+};
+
+// 等待一段时间，在到期后的第一个控制周期恢复
+struct Sleep {
+    int64_t durationNs;
+
+    [[nodiscard]] bool await_ready() const noexcept { return durationNs <= 0; }
+    void await_suspend(ControlTask::Handle handle) const noexcept {
+        ControlTask::promise_type& root = *handle.promise().root;
+        root.leaf = handle;
+        root.wait = ControlTask::Wait::TIME;
+        root.wakeNs = root.scheduler->now() + durationNs;
+    }
+    void await_resume() const noexcept {}
+};
+
+// 每个控制周期检查一次谓词，成立时恢复；带超时时 co_await 的结果为 false 表示超时
+template<typename Predicate>
+struct Until {
+    Predicate predicate;
+    int64_t timeoutNs;
+    ControlTask::promise_type* root = nullptr;
+
+    [[nodiscard]] bool await_ready() { return predicate(); }
+    void await_suspend(ControlTask::Handle handle) noexcept {
+        root = handle.promise().root;
+        root->leaf = handle;
+        root->wait = ControlTask::Wait::CONDITION;
+        root->wakeNs = timeoutNs < 0 ? std::numeric_limits<int64_t>::max() : root->scheduler->now() + timeoutNs;
+        root->condition = [](void* context) { return static_cast<Until*>(context)->predicate(); };
+        root->conditionContext = this;
+    }
+    bool await_resume() const noexcept { return root == nullptr || root->conditionMet; }
+};
+
+inline NextTick nextTick() {
+    return {};
+}
+
+template<typename Rep, typename Period>
+Sleep sleep(std::chrono::duration<Rep, Period> duration) {
+    return {std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()};
+}
+
+template<typename Predicate>
+Until<Predicate> until(Predicate predicate) {
+    return {std::move(predicate), -1};
+}
+
+template<typename Predicate, typename Rep, typename Period>
+Until<Predicate> until(Predicate predicate, std::chrono::duration<Rep, Period> timeout) {
+    return {std::move(predicate), std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count()};
+}
+
+} // namespace control
+
+#endif // CONTROL_TASK_H
@@ -0,0 +1,167 @@
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+// 底盘坐标系下的速度指令：vx 向前、vy 向左（m/s），wz 逆时针（rad/s）
+struct BodyTwist {
+    float vx = 0.0f;
+    float vy = 0.0f;
+    float wz = 0.0f;
+};
+
+// 线性运动学：关节量 q = A · [vx, vy, wz]ᵀ，正解取最小二乘伪逆 (AᵀA)⁻¹Aᵀ，关节数多于 3 时对测量噪声做平均。
+// 批量接口为 SoA 布局：关节 j 的第 k 个样本位于 joints[j * count + k]，内层循环连续访问，编译器可向量化
+template<size_t N>
+class LinearKinematics {
+public:
+    static constexpr size_t JOINTS = N;
+    using Matrix = std::array<std::array<float, 3>, N>;
+
+    explicit LinearKinematics(const Matrix& matrix) : inverse_(matrix) {
+        computeForward();
+    }
+
+    // 逆解：体速度 -> N 个关节量
+    void inverse(const BodyTwist& twist, float* joints) const {
+        for (size_t j = 0; j < N; ++j) {
+            joints[j] = inverse_[j][0] * twist.vx + inverse_[j][1] * twist.vy + inverse_[j][2] * twist.wz;
+        }
+    }
+
+    // 正解：N 个关节量 -> 体速度（最小二乘）
+    BodyTwist forward(const float* joints) const {
+        float v[3] = {0.0f, 0.0f, 0.0f};
+        for (size_t r = 0; r < 3; ++r) {
+            for (size_t j = 0; j < N; ++j) {
+                v[r] += forward_[r][j] * joints[j];
+            }
+        }
+        return {v[0], v[1], v[2]};
+    }
+
+    void inverseBatch(const float* vx, const float* vy, const float* wz, size_t count, float* joints) const {
+        for (size_t j = 0; j < N; ++j) {
+            const float a = inverse_[j][0];
+            const float b = inverse_[j][1];
+            const float c = inverse_[j][2];
+            float* out = joints + j * count;
+            for (size_t k = 0; k < count; ++k) {
+                out[k] = a * vx[k] + b * vy[k] + c * wz[k];
+            }
+        }
+    }
+
+    void forwardBatch(const float* joints, size_t count, float* vx, float* vy, float* wz) const {
+        float* outputs[3] = {vx, vy, wz};
+        for (size_t r = 0; r < 3; ++r) {
+            float* out = outputs[r];
+            for (size_t k = 0; k < count; ++k) {
+                out[k] = 0.0f;
+            }
+            for (size_t j = 0; j < N; ++j) {
+                const float g = forward_[r][j];
+                const float* in = joints + j * count;
+                for (size_t k = 0; k < count; ++k) {
+                    out[k] += g * in[k];
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] const Matrix& inverseMatrix() const { return inverse_; }
+
+private:
+    void computeForward() {
+        // AᵀA 为 3x3 对称阵，伴随矩阵求逆
+        double m[3][3] = {};
+        for (size_t j = 0; j < N; ++j) {
+            for (size_t r = 0; r < 3; ++r) {
+                for (size_t c = 0; c < 3; ++c) {
+                    m[r][c] += static_cast<double>(inverse_[j][r]) * inverse_[j][c];
+                }
+            }
+        }
+        const double c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+        const double c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+        const double c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+        const double det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+        const double inv[3][3] = {
+            {c00 / det, (m[0][2] * m[2][1] - m[0][1] * m[2][2]) / det, (m[0][1] * m[1][2] - m[0][2] * m[1][1]) / det},
+            {c01 / det, (m[0][0] * m[2][2] - m[0][2] * m[2][0]) / det, (m[0][2] * m[1][0] - m[0][0] * m[1][2]) / det},
+            {c02 / det, (m[0][1] * m[2][0] - m[0][0] * m[2][1]) / det, (m[0][0] * m[1][1] - m[0][1] * m[1][0]) / det}};
+        for (size_t r = 0; r < 3; ++r) {
+            for (size_t j = 0; j < N; ++j) {
+                double sum = 0.0;
+                for (size_t c = 0; c < 3; ++c) {
+                    sum += inv[r][c] * inverse_[j][c];
+                }
+                forward_[r][j] = static_cast<float>(sum);
+            }
+        }
+    }
+
+    Matrix inverse_;
+    std::array<std::array<float, N>, 3> forward_{};
+};
+
+// 麦克纳姆轮底盘（X 型辊子布置），关节顺序：左前、右前、左后、右后，关节量为轮角速度（rad/s，使车前进为正）
+class MecanumKinematics : public LinearKinematics<4> {
+public:
+    // halfLength / halfWidth 为轮心到底盘中心的纵向 / 横向距离（m）
+    MecanumKinematics(float wheelRadius, float halfLength, float halfWidth);
+};
+
+// 舵轮模块指令：朝向（rad，底盘坐标系，0 为正前方）与轮角速度（rad/s）
+struct ModuleState {
+    float steer = 0.0f;
+    float speed = 0.0f;
+};
+
+// 四舵轮底盘，模块顺序：左前、右前、左后、右后。
+// 模块速度分量对体速度是线性的（LinearKinematics<8>，行 2i / 2i+1 为模块 i 的 x / y 分量），
+// 逆解再换算为朝向与轮速
+class SwerveKinematics {
+public:
+    static constexpr size_t MODULES = 4;
+    using Positions = std::array<std::array<float, 2>, MODULES>;   // 各模块相对底盘中心的 (x, y)（m）
+
+    SwerveKinematics(float wheelRadius, const Positions& positions);
+
+    // currentSteer 为各模块当前朝向：转向超过 90° 时改为反转驱动，转向量不超过 90°；
+    // 速度为 0 时保持当前朝向
+    void inverse(const BodyTwist& twist, const float* currentSteer, ModuleState* modules) const;
+    BodyTwist forward(const ModuleState* modules) const;
+
+    // 批量逆解（不做反转优化，朝向位于 (-π, π]），steer / speed 为 SoA：模块 m 的第 k 个样本在 [m * count + k]
+    void inverseBatch(const float* vx, const float* vy, const float* wz, size_t count,
+                      float* steer, float* speed) const;
+
+private:
+    float radius;
+    Positions positions;
+    LinearKinematics<2 * MODULES> components;
+};
+
+// 两轴云台：yaw 绕 z 轴逆时针为正，pitch 抬头为正（rad）；关节角与视线方向互相换算
+class GimbalKinematics {
+public:
+    GimbalKinematics(float pitchMin, float pitchMax);
+
+    // 视线方向（不必归一化）-> 关节角；pitch 限幅，yaw 取离 currentYaw 最近的多圈角度
+    void inverse(float x, float y, float z, float currentYaw, float& yaw, float& pitch) const;
+    // 关节角 -> 单位视线方向
+    void forward(float yaw, float pitch, float& x, float& y, float& z) const;
+
+    // 批量换算（yaw 位于 (-π, π]）
+    void inverseBatch(const float* x, const float* y, const float* z, size_t count, float* yaw, float* pitch) const;
+    void forwardBatch(const float* yaw, const float* pitch, size_t count, float* x, float* y, float* z) const;
+
+private:
+    float pitchMin;
+    float pitchMax;
+};
+
+#endif // KINEMATICS_H
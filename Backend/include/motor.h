@@ -2,37 +2,139 @@
 #define MOTOR_H
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include "transport.h"
+#include "safety_guard.h"
+#include "seqlock.h"
+#include "clock_sync.h"
+#include "state_estimator.h"
 
 class MotorCommunication;
+class MotorGroup;
+
+// 链路状态，由通信线程与连接监管线程发布
+enum class LinkState : uint8_t {
+    DISCONNECTED,  // 未连接或链路已断开
+    CONNECTING,    // 正在建立连接 / 已连接但尚未收到新的反馈
+    UP,            // 连接正常，反馈新鲜
+    STALE,         // 已连接但反馈超时，即将重连
+    BACKOFF        // 重连失败，等待下一次重试
+};
+
+// 一帧反馈对应的完整状态，时间均为上位机 steady_clock 纳秒
+struct MotorState {
+    float angle = 0.0f;         // 度，设备上报的回绕角度
+    double position = 0.0;      // 度，展开后的多圈位置
+    int64_t turns = 0;          // 向下取整的圈数
+    float omega = 0.0f;         // rad/s
+    float current = 0.0f;       // A（v2 可选字段）
+    float temperature = 0.0f;   // ℃（v2 可选字段）
+    int64_t sampleTimeNs = 0;   // 采样时刻：有设备时间戳且时钟已同步时由设备时间换算，否则为到达时刻
+    int64_t receiveTimeNs = 0;  // 反馈到达时刻
+    int64_t commandTimeNs = 0;  // 设备回显的指令发送时刻（v2 指令时间戳），与 receiveTimeNs 之差即往返时间；无回显时为 0
+    uint64_t sequence = 0;      // 收到的反馈计数，0 表示尚无反馈
+};
 
 class Motor {
 public:
     Motor(int motorId = 0);
     ~Motor();
 
-    bool connect(const std::string& ipAddress = "127.0.0.1", int port = 6000);
+    bool connect(const std::string& ipAddress = "127.0.0.1", int port = 6000,
+                 const TransportOptions& options = TransportOptions{});
+    bool connect(std::unique_ptr<Transport> transport);
+    // 按 URI 选择链路，如 tcp://127.0.0.1:6000、serial:///dev/ttyUSB0?baud=921600
+    bool connectUri(const std::string& uri);
+    // 协议版本（默认 v1），在 connect 之前设置；URI 中的 protocol / crc / stamp 参数同样生效
+    void setProtocol(const ProtocolOptions& options);
+    ProtocolOptions getProtocol() const;
+    // 用上一次的链路参数重新连接（模拟器重启、线缆抖动后恢复）
+    bool reconnect();
+    // 主动断开：连接监管不再重连该电机，直到再次调用 connect / connectUri / reconnect
     void disconnect();
     bool isConnected() const;
 
     void setTorque(float torqueNm);
+    // 属于电机组时返回组内最近一次发布的力矩；离开组后为 0，直到再次 setTorque
     float getTorque() const;
+    MotorGroup* getGroup() const;
 
     float getCurrentAngle() const;
+    // 接收线程逐帧展开的多圈位置（度）与圈数，位置环直接使用，不需要在控制循环里处理回绕
+    double getPosition() const;
+    int64_t getTurns() const;
     float getCurrentOmega() const;
+    // v2 协议可选字段，设备未上报时保持 0
+    float getMotorCurrent() const;
+    float getTemperature() const;
+
+    // 最新一帧反馈的一致快照（角度、速度与采样时刻来自同一帧）
+    MotorState getState() const;
+    // 与设备的时钟同步估计（需 v2 反馈携带设备时间戳）
+    ClockSync::Estimate getClockSync() const;
+    // 卡尔曼滤波后的状态（角度已展开，含角加速度），每帧反馈在接收线程中更新
+    EstimatedState getEstimate() const;
+    // 滤波状态按常加速度外推到 timeNs（steady_clock 纳秒），外推不超过 maxHorizon 秒
+    EstimatedState predict(int64_t timeNs, float maxHorizon = 0.05f) const;
+    // 估计器噪声参数，下一帧反馈时生效
+    void setEstimatorConfig(const EstimatorConfig& config);
+    EstimatorConfig getEstimatorConfig() const;
     int getMotorId() const;
 
+    // 链路统计：收发计数、丢包 / 乱序 / 重复（UDP）、校验错误；连接 / 重连进行中时等待其完成，不可在收发线程中调用
+    TransportStats getLinkStats() const;
+
+    LinkState getLinkState() const;
+    // 距最近一次有效反馈的时间（秒），从未收到反馈时为无穷大
+    double getFeedbackAge() const;
+
+    // 保持零力矩：置位后发送线程只发送 0，setTorque 的值保留但不下发
+    void setHoldZeroTorque(bool hold);
+    bool isHoldingZeroTorque() const;
+    // 经零力矩保持后的请求力矩，发送前还要经过安全层
+    float getCommandTorque() const;
+    // 经安全层后最近一次实际下发的力矩（急停、看门狗、限幅之后的值），链路断开后为 0
+    float getAppliedTorque() const;
+
+    // 发送路径上的安全限制：反馈看门狗、力矩 / 变化率 / 角度包络限幅
+    void setSafetyLimits(const SafetyLimits& limits);
+    SafetyLimits getSafetyLimits() const;
+    SafetyStats getSafetyStats() const;
+
+    static int64_t steadyNowNs();
+
 private:
     int motorId;
 
     std::unique_ptr<MotorCommunication> communication;
 
     std::atomic<float> torqueToSend;
+    std::atomic<float> appliedTorque;
     std::atomic<float> currentAngle;
     std::atomic<float> currentOmega;
+    std::atomic<double> position;
+    std::atomic<float> motorCurrent;
+    std::atomic<float> temperature;
+    std::atomic<int64_t> lastFeedbackNs;
+    std::atomic<LinkState> linkState;
+    std::atomic<bool> holdZeroTorque;
+    std::atomic<bool> disconnectRequested;
+    SeqLock<MotorState> state;
+    SeqLock<ClockSync::Estimate> clockEstimate;
+    SeqLock<EstimatedState> estimate;
+    SeqLock<EstimatorConfig> estimatorConfig;
+    std::atomic<bool> estimatorConfigChanged;
+    std::atomic<MotorGroup*> group;
+    size_t groupIndex;
+    // 正在经由 group 读取力矩的线程数，组解除时等待其归零
+    mutable std::atomic<int> groupReaders;
+    SafetyGuard safety;
 
     friend class MotorCommunication;
+    friend class ConnectionSupervisor;
+    friend class MotorGroup;
 };
 
 #endif // MOTOR_H
\ No newline at end of file
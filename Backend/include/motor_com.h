@@ -1,12 +1,16 @@
 #ifndef MOTOR_COM_H
 #define MOTOR_COM_H
 
-#include <winsock2.h>
 #include <string>
 #include <thread>
 #include <mutex>
 #include <atomic>
-#include <vector>
+#include <memory>
+#include "packet_framer.h"
+#include "transport.h"
+#include "clock_sync.h"
+#include "state_estimator.h"
+#include "angle_tracker.h"
 
 class Motor;
 
@@ -15,16 +19,27 @@ public:
     explicit MotorCommunication(Motor* motor);
     ~MotorCommunication();
 
-    bool connect(const std::string& ipAddress, int port);
+    bool connect(const std::string& ipAddress, int port, const TransportOptions& options = TransportOptions{});
+    bool connect(std::unique_ptr<Transport> transport);
+    // 用已有的传输层重新建立连接（先停止旧线程、关闭旧连接），供断线重连使用
+    bool reconnect();
     void disconnect();
+    // 收发线程在运行且未因链路错误退出
     [[nodiscard]] bool isConnected() const;
+    // 协议版本与 CRC 类型，下次建立连接时生效
+    void setProtocol(const ProtocolOptions& options);
+    [[nodiscard]] ProtocolOptions protocol() const;
     void processReceivedData();
+    [[nodiscard]] TransportStats stats() const;
 
 private:
-    SOCKET sock;
-    bool connected;
+    std::unique_ptr<Transport> transport;
+    std::atomic<bool> connected;
     std::atomic<bool> shouldExit;
 
+    // connect / reconnect / disconnect 可能来自控制线程与监管线程，串行执行
+    mutable std::mutex lifecycleMutex;
+
     Motor* motor;
     
     // Threads
@@ -33,14 +48,19 @@ private:
 
     std::mutex consoleMutex;
 
-    std::vector<uint8_t> receiveBuffer;
-    size_t bufferPosition;
+    ProtocolOptions protocolOptions;
+    FeedbackFramer framer;
+    ClockSync clockSync;
+    AngleTracker angleTracker;
+    StateEstimator estimator;
+    uint64_t feedbackCount;
+    uint64_t reportedChecksumErrors;
+    std::atomic<uint64_t> checksumErrors;
 
-    void sendThreadFunc();
+    bool startLocked();
+    void stopLocked();
+    void sendThreadFunc(ProtocolOptions options);
     void receiveThreadFunc();
-    
-    // Winsock
-    static bool initializeWinsock();
 };
 
-#endif // MOTOR_COM_H
\ No newline at end of file
+#endif // MOTOR_COM_H
@@ -0,0 +1,70 @@
+#ifndef MOTOR_GROUP_H
+#define MOTOR_GROUP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "seqlock.h"
+
+class Motor;
+
+// 电机组：组内所有成员的力矩作为一帧整体发布（顺序锁双缓冲），读取方不会看到只写了一半的帧。
+// 各成员的发送线程仍按各自的 1 ms 周期独立取最新一帧，新帧发布的瞬间不同成员可能相差一个发送周期。
+// 加入组后成员的力矩由组下发，Motor::setTorque 不再生效；离开组（detach 或组析构）时成员力矩清零，
+// 并等待其发送线程退出对组的读取后才返回，组随后可以安全销毁
+class MotorGroup {
+public:
+    static constexpr size_t MAX_MEMBERS = 16;
+
+    // 一帧指令
+    struct Command {
+        uint64_t generation = 0;
+        float torque[MAX_MEMBERS] = {};
+    };
+
+    // 成员状态快照，按成员顺序排列（SoA，便于批量正运动学）
+    struct Joints {
+        size_t count = 0;
+        double position[MAX_MEMBERS] = {};   // 度，多圈展开
+        float omega[MAX_MEMBERS] = {};       // rad/s
+        int64_t sampleTimeNs[MAX_MEMBERS] = {};
+    };
+
+    explicit MotorGroup(std::string name);
+    ~MotorGroup();
+    MotorGroup(const MotorGroup&) = delete;
+    MotorGroup& operator=(const MotorGroup&) = delete;
+
+    // 成员配置须在开始 publish 之前完成；电机已属于其他组时失败
+    bool add(Motor* motor);
+    // 电机被移除时调用，对应位置此后不再下发，成员回落为零力矩
+    void detach(Motor* motor);
+
+    [[nodiscard]] const std::string& name() const;
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] Motor* member(size_t index) const;
+    [[nodiscard]] bool contains(const Motor* motor) const;
+
+    // 发布 size() 个力矩（Nm，按成员顺序）；publish 与 zero 是同一写者，仅允许一个控制线程调用
+    void publish(const float* torques);
+    void zero();
+    [[nodiscard]] Command command() const;
+    [[nodiscard]] uint64_t generation() const;
+
+    // 发送线程读取成员 index 的当前指令
+    [[nodiscard]] float commandTorque(size_t index) const;
+
+    void readJoints(Joints& joints) const;
+
+private:
+    // 力矩清零、解除组指针，并等待该电机发送线程中进行的组读取结束
+    static void release(Motor* motor);
+
+    std::string groupName;
+    std::vector<Motor*> members;
+    SeqLock<Command> current;
+    uint64_t published;
+};
+
+#endif // MOTOR_GROUP_H
@@ -4,7 +4,10 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include "motor.h"
+#include "motor_group.h"
+#include "connection_supervisor.h"
 
 class MotorManager {
 public:
@@ -16,15 +19,35 @@ public:
     Motor* getMotor(int motorId);
     void removeMotor(int motorId);
 
+    // 电机组：成员按 motorIds 顺序排列，任一电机不存在或已属于其他组时失败
+    MotorGroup* createGroup(const std::string& name, const std::vector<int>& motorIds);
+    MotorGroup* getGroup(const std::string& name);
+    // 成员力矩清零并等待各发送线程退出对组的读取后销毁组，之后 setTorque 重新生效
+    void removeGroup(const std::string& name);
+
     // 连接单个电机到指定服务器和端口
-    bool connectMotor(int motorId, const std::string& ipAddress = "127.0.0.1", int port = 6000);
+    bool connectMotor(int motorId, const std::string& ipAddress = "127.0.0.1", int port = 6000,
+                      const TransportOptions& options = TransportOptions{});
+
+    // 按 URI 连接单个电机（tcp:// 或 serial://）
+    bool connectMotorUri(int motorId, const std::string& uri);
 
-    // 连接所有电机（使用递增端口）
-    bool connectAll(const std::string& ipAddress = "127.0.0.1", int basePort = 6000);
+    // 并行连接所有电机（使用递增端口）
+    bool connectAll(const std::string& ipAddress = "127.0.0.1", int basePort = 6000,
+                    const TransportOptions& options = TransportOptions{});
 
     // 断开所有电机
     void disconnectAll();
 
+    // 全局急停：锁存，所有电机在一个发送周期内输出零力矩，解除前 setTorque 不生效
+    void emergencyStop();
+    void clearEmergencyStop();
+
+    // 连接监管：监管当前已创建的全部电机，反馈超时或断线时自动重连
+    void startSupervisor(const ConnectionSupervisor::Config& config = ConnectionSupervisor::Config{});
+    void stopSupervisor();
+    ConnectionSupervisor& getSupervisor();
+
 private:
     MotorManager() = default;
     ~MotorManager();
@@ -35,6 +58,9 @@ private:
     MotorManager& operator=(MotorManager&&) = delete;
 
     std::map<int, std::unique_ptr<Motor>> motors;
+    // 声明在 motors 之后，析构时先于电机销毁
+    std::map<std::string, std::unique_ptr<MotorGroup>> groups;
+    ConnectionSupervisor supervisor;
 };
 
 #endif // MOTOR_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef PACKET_FRAMER_H
+#define PACKET_FRAMER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "protocol.h"
+
+// 通信协议常量
+constexpr uint8_t FEEDBACK_HEADER = 0xA0;
+constexpr uint8_t COMMAND_HEADER = 0xA1;
+constexpr size_t FEEDBACK_PACKET_SIZE = 11; // A0 + ID + Angle(4) + Speed(4) + Checksum
+constexpr size_t COMMAND_PACKET_SIZE = 7;   // A1 + ID + Torque(4) + Checksum
+
+// XOR 校验
+uint8_t xorChecksum(const uint8_t* data, size_t size);
+
+// 编码控制指令包，out 至少 COMMAND_PACKET_SIZE 字节
+void encodeCommand(uint8_t motorId, float torque, uint8_t* out);
+
+// 按协议选项编码，返回包长度；v1 忽略 torque 以外的字段
+constexpr size_t MAX_COMMAND_SIZE = protocol::CommandLayout::MAX_FRAME;
+constexpr size_t MAX_FEEDBACK_SIZE = protocol::FeedbackLayout::MAX_FRAME;
+size_t encodeCommand(const CommandMessage& command, const ProtocolOptions& options, uint8_t* out);
+size_t encodeFeedback(const FeedbackMessage& feedback, const ProtocolOptions& options, uint8_t* out);
+
+// 反馈包组帧：与具体传输层无关，传输层直接把数据读入 writePtr()，
+// 再由 next() 逐个取出完整且校验通过的反馈包
+class FeedbackFramer {
+public:
+    using Feedback = FeedbackMessage;
+
+    explicit FeedbackFramer(size_t capacity = 256, ProtocolVersion version = ProtocolVersion::V1);
+
+    // 切换协议版本并清空缓冲区
+    void setVersion(ProtocolVersion version);
+    [[nodiscard]] ProtocolVersion version() const;
+
+    // 接收缓冲区写入接口
+    uint8_t* writePtr();
+    [[nodiscard]] size_t writable() const;
+    void commit(size_t size);
+
+    // 拷贝写入（用于测试与基准）
+    size_t push(const uint8_t* data, size_t size);
+
+    // 取出下一个完整反馈包，数据不足时返回 false
+    bool next(Feedback& feedback);
+
+    void clear();
+    [[nodiscard]] size_t buffered() const;
+    [[nodiscard]] uint64_t checksumErrors() const;
+
+private:
+    bool nextV1(Feedback& feedback);
+    bool nextV2(Feedback& feedback);
+    void compact();
+
+    std::vector<uint8_t> buffer;
+    size_t readPosition;
+    size_t writePosition;
+    uint64_t checksumErrorCount;
+    ProtocolVersion protocolVersion;
+    size_t minFrame;  // 可能成帧的最少字节数
+};
+
+#endif // PACKET_FRAMER_H
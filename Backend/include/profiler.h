@@ -0,0 +1,126 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 内置剖析，不需要外部工具即可在运行中的程序上使用：
+//   PROFILE_ZONE("name") 对所在作用域计时（RAII），按计时点累计调用次数、总耗时与最大耗时；
+//   开启追踪后每次调用的起止时刻写入所在线程的环形缓冲区，可导出为 Chrome trace-event JSON
+//   （chrome://tracing 或 Perfetto 直接打开）；
+//   各线程 CPU 时间与上下文切换次数取自 /proc/self/task（Linux）或 GetThreadTimes（Windows，无切换次数）；
+//   MetricsServer 在本机端口提供 /metrics（Prometheus 文本格式）与 /trace。
+// 未定义 CONTROLRY_PROFILING 时 PROFILE_ZONE 展开为空语句，计时代码不参与编译
+namespace profiler {
+
+// 一个计时点，静态存储，首次执行时加入全局列表。计数用 relaxed 原子量，多个线程可共用一个计时点
+class Site {
+public:
+    explicit Site(const char* name);
+
+    Site(const Site&) = delete;
+    Site& operator=(const Site&) = delete;
+
+    void record(int64_t durationNs);
+
+    [[nodiscard]] const char* name() const;
+    [[nodiscard]] uint64_t count() const;
+    [[nodiscard]] uint64_t totalNs() const;
+    [[nodiscard]] uint64_t maxNs() const;
+
+private:
+    const char* siteName;
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> maximum;
+};
+
+class Zone {
+public:
+    explicit Zone(Site& site);
+    ~Zone();
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+private:
+    Site& site;
+    int64_t startNs;
+};
+
+// 命名当前线程，用于追踪与统计输出；Linux 上同时设置系统线程名（截断为 15 个字符）
+void setThreadName(const std::string& name);
+
+// 追踪开关。每个线程保留最近 eventsPerThread 个事件；缓冲区在开启追踪时（之后新建的线程在 setThreadName 时）
+// 分配，实时线程记录事件时不分配内存（未命名且在开启追踪之后才创建的线程除外）
+void setTracing(bool enabled);
+[[nodiscard]] bool isTracing();
+void setTraceCapacity(size_t eventsPerThread);
+void clearTrace();
+
+struct ZoneStats {
+    std::string name;
+    uint64_t count = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+};
+
+struct ThreadStats {
+    int64_t id = 0;                    // 系统线程 ID
+    std::string name;
+    double userSeconds = 0.0;
+    double systemSeconds = 0.0;
+    uint64_t voluntarySwitches = 0;    // 主动让出（阻塞、休眠）
+    uint64_t involuntarySwitches = 0;  // 被抢占，持续增长说明 CPU 不够用
+};
+
+[[nodiscard]] std::vector<ZoneStats> zoneStats();
+// 进程内全部线程（Linux）或已命名的线程（其他平台）
+[[nodiscard]] std::vector<ThreadStats> threadStats();
+// 整个进程（getrusage / GetProcessTimes），id 为 0
+[[nodiscard]] ThreadStats processStats();
+
+// 导出时每个线程只在拷贝事件期间持锁，格式化在锁外进行，不阻塞被追踪的线程
+[[nodiscard]] std::string chromeTrace();
+bool writeChromeTrace(const std::string& path);
+[[nodiscard]] std::string metricsText();
+
+// 简单的 HTTP 端点：GET /metrics、/trace、/trace/start、/trace/stop，每个连接处理一个请求后关闭
+class MetricsServer {
+public:
+    MetricsServer();
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    // loopbackOnly 为 false 时监听所有网卡；端口被占用时返回 false
+    bool start(int port, bool loopbackOnly = true);
+    void stop();
+    [[nodiscard]] bool isRunning() const;
+
+private:
+    void run();
+
+    std::intptr_t listener;  // socket_t，头文件中不引入平台 socket 头，避免与 windows.h 的包含顺序冲突
+    std::atomic<bool> running;
+    std::thread thread;
+};
+
+} // namespace profiler
+
+#ifdef CONTROLRY_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name)                                                          \
+    static ::profiler::Site PROFILE_CONCAT(profileSite, __LINE__){name};           \
+    const ::profiler::Zone PROFILE_CONCAT(profileZone, __LINE__){PROFILE_CONCAT(profileSite, __LINE__)}
+#else
+#define PROFILE_ZONE(name) static_cast<void>(0)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,235 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// 协议版本：v1 为原有的 A0 / A1 定长包 + XOR 校验，v2 为带 CRC、版本号与可选字段的帧
+enum class ProtocolVersion : uint8_t {
+    V1 = 1,
+    V2 = 2
+};
+
+enum class CrcKind : uint8_t {
+    CRC16,   // CRC-16/CCITT-FALSE，2 字节
+    CRC32C   // CRC-32C (Castagnoli)，4 字节，有硬件指令时开销更低
+};
+
+struct ProtocolOptions {
+    ProtocolVersion version = ProtocolVersion::V1;
+    CrcKind crc = CrcKind::CRC16;
+    bool commandTimestamp = false;  // v2 指令包携带上位机时间戳，设备在反馈中回显
+};
+
+namespace protocol {
+
+static_assert(std::endian::native == std::endian::little, "协议字段按小端直接拷贝");
+
+// v2 帧格式：
+//   [0] 0xA2  [1] 版本(高 4 位) | CRC 类型(bit3) | 包类型(低 3 位)  [2] 电机 ID  [3] 字段掩码
+//   [4..]  掩码中置位的字段，按位序排列，小端
+//   [末尾] CRC16 (2 字节) 或 CRC32C (4 字节)，覆盖之前的所有字节
+constexpr uint8_t V2_HEADER = 0xA2;
+constexpr uint8_t V2_VERSION = 2;
+constexpr uint8_t TYPE_FEEDBACK = 0;
+constexpr uint8_t TYPE_COMMAND = 1;
+constexpr size_t V2_PREFIX_SIZE = 4;
+constexpr uint8_t CRC32C_FLAG = 0x08;
+constexpr uint8_t TYPE_MASK = 0x07;
+
+constexpr uint8_t versionByte(uint8_t type, CrcKind crc) {
+    return static_cast<uint8_t>((V2_VERSION << 4) | (crc == CrcKind::CRC32C ? CRC32C_FLAG : 0) | type);
+}
+
+constexpr size_t crcSize(CrcKind crc) {
+    return crc == CrcKind::CRC32C ? 4 : 2;
+}
+
+uint16_t crc16(const uint8_t* data, size_t size);
+uint32_t crc32c(const uint8_t* data, size_t size);
+// 查表实现，用于在有硬件加速时对照
+uint32_t crc32cSoftware(const uint8_t* data, size_t size);
+
+// 字段描述：Member 为消息结构体的成员指针，Bit 为其在字段掩码中的位
+template<auto Member>
+struct MemberTraits;
+
+template<typename Owner, typename T, T Owner::*Member>
+struct MemberTraits<Member> {
+    using owner = Owner;
+    using type = T;
+};
+
+template<auto Member, unsigned Bit>
+struct Field {
+    static_assert(Bit < 8, "字段掩码只有 8 位");
+    using owner = typename MemberTraits<Member>::owner;
+    using type = typename MemberTraits<Member>::type;
+    static constexpr unsigned bit = Bit;
+    static constexpr uint8_t mask = static_cast<uint8_t>(1u << Bit);
+    static constexpr size_t size = sizeof(type);
+
+    static uint8_t* write(const owner& message, uint8_t* out) {
+        std::memcpy(out, &(message.*Member), size);
+        return out + size;
+    }
+    static const uint8_t* read(const uint8_t* in, owner& message) {
+        std::memcpy(&(message.*Member), in, size);
+        return in + size;
+    }
+};
+
+// 包描述：字段按位序列出，编解码由折叠表达式在编译期展开，
+// 每种掩码对应的负载长度预先算成查找表，运行时不做任何字段解析
+template<typename MessageT, uint8_t Type, typename... Fields>
+struct Layout {
+    using Message = MessageT;
+    static constexpr uint8_t TYPE = Type;
+    static constexpr uint8_t FIELDS = (Fields::mask | ...);
+
+    static constexpr size_t payloadSize(uint8_t mask) {
+        return ((mask & Fields::mask ? Fields::size : 0) + ...);
+    }
+
+    static constexpr size_t MAX_PAYLOAD = payloadSize(FIELDS);
+    static constexpr size_t MAX_FRAME = V2_PREFIX_SIZE + MAX_PAYLOAD + 4;
+    static constexpr uint8_t INVALID = 0xFF;
+
+    static_assert(MAX_PAYLOAD < INVALID, "负载过长");
+
+    // 掩码 -> 负载长度，含未定义字段的掩码为 INVALID
+    static constexpr std::array<uint8_t, 256> PAYLOAD_SIZE = [] {
+        std::array<uint8_t, 256> table{};
+        for (unsigned mask = 0; mask < 256; ++mask) {
+            table[mask] = (mask & ~FIELDS) ? INVALID : static_cast<uint8_t>(payloadSize(static_cast<uint8_t>(mask)));
+        }
+        return table;
+    }();
+
+    static uint8_t* writePayload(const Message& message, uint8_t mask, uint8_t* out) {
+        ((out = (mask & Fields::mask) ? Fields::write(message, out) : out), ...);
+        return out;
+    }
+
+    static const uint8_t* readPayload(const uint8_t* in, uint8_t mask, Message& message) {
+        ((in = (mask & Fields::mask) ? Fields::read(in, message) : in), ...);
+        return in;
+    }
+
+private:
+    static constexpr bool ascending() {
+        unsigned bits[] = {Fields::bit...};
+        for (size_t i = 1; i < sizeof...(Fields); ++i) {
+            if (bits[i] <= bits[i - 1]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    static_assert(ascending(), "字段须按位序升序排列且不重复");
+};
+
+// 编码一帧，返回帧长度；out 至少 L::MAX_FRAME 字节
+template<typename L>
+size_t encode(const typename L::Message& message, CrcKind crc, uint8_t* out) {
+    const uint8_t mask = message.fields & L::FIELDS;
+    out[0] = V2_HEADER;
+    out[1] = versionByte(L::TYPE, crc);
+    out[2] = message.motorId;
+    out[3] = mask;
+    const size_t size = static_cast<size_t>(L::writePayload(message, mask, out + V2_PREFIX_SIZE) - out);
+    if (crc == CrcKind::CRC32C) {
+        const uint32_t value = crc32c(out, size);
+        std::memcpy(out + size, &value, 4);
+    } else {
+        const uint16_t value = crc16(out, size);
+        std::memcpy(out + size, &value, 2);
+    }
+    return size + crcSize(crc);
+}
+
+// 从 data 起始处解析一帧（data[0] 须为 V2_HEADER）：
+// 返回帧长度；数据不足返回 0；版本、类型、掩码或 CRC 不符返回 -1
+template<typename L>
+int decode(const uint8_t* data, size_t size, typename L::Message& message) {
+    if (size < V2_PREFIX_SIZE) {
+        return 0;
+    }
+    const uint8_t version = data[1];
+    const uint8_t payload = L::PAYLOAD_SIZE[data[3]];
+    if ((version >> 4) != V2_VERSION || (version & TYPE_MASK) != L::TYPE || payload == L::INVALID) {
+        return -1;
+    }
+
+    const CrcKind crc = (version & CRC32C_FLAG) ? CrcKind::CRC32C : CrcKind::CRC16;
+    const size_t body = V2_PREFIX_SIZE + payload;
+    const size_t frame = body + crcSize(crc);
+    if (size < frame) {
+        return 0;
+    }
+
+    if (crc == CrcKind::CRC32C) {
+        uint32_t expected;
+        std::memcpy(&expected, data + body, 4);
+        if (crc32c(data, body) != expected) {
+            return -1;
+        }
+    } else {
+        uint16_t expected;
+        std::memcpy(&expected, data + body, 2);
+        if (crc16(data, body) != expected) {
+            return -1;
+        }
+    }
+
+    message.motorId = data[2];
+    message.fields = data[3];
+    L::readPayload(data + V2_PREFIX_SIZE, data[3], message);
+    return static_cast<int>(frame);
+}
+
+} // namespace protocol
+
+// 反馈消息：v1 只填 angle / omega，v2 按 fields 掩码填写
+struct FeedbackMessage {
+    uint8_t motorId = 0;
+    uint8_t fields = 0;
+    float angle = 0.0f;           // 度
+    float omega = 0.0f;           // rad/s
+    float current = 0.0f;         // A
+    float temperature = 0.0f;     // ℃
+    uint32_t deviceTimeUs = 0;    // 设备时钟（微秒，回绕）
+    uint64_t commandTimeNs = 0;   // 回显最近一次指令的上位机时间戳
+};
+
+struct CommandMessage {
+    uint8_t motorId = 0;
+    uint8_t fields = 0;
+    float torque = 0.0f;          // Nm
+    uint64_t hostTimeNs = 0;      // 上位机发送时刻
+};
+
+namespace protocol {
+
+using FeedbackAngle = Field<&FeedbackMessage::angle, 0>;
+using FeedbackOmega = Field<&FeedbackMessage::omega, 1>;
+using FeedbackCurrent = Field<&FeedbackMessage::current, 2>;
+using FeedbackTemperature = Field<&FeedbackMessage::temperature, 3>;
+using FeedbackDeviceTime = Field<&FeedbackMessage::deviceTimeUs, 4>;
+using FeedbackCommandTime = Field<&FeedbackMessage::commandTimeNs, 5>;
+
+using FeedbackLayout = Layout<FeedbackMessage, TYPE_FEEDBACK,
+                              FeedbackAngle, FeedbackOmega, FeedbackCurrent,
+                              FeedbackTemperature, FeedbackDeviceTime, FeedbackCommandTime>;
+
+using CommandTorque = Field<&CommandMessage::torque, 0>;
+using CommandHostTime = Field<&CommandMessage::hostTimeNs, 1>;
+
+using CommandLayout = Layout<CommandMessage, TYPE_COMMAND, CommandTorque, CommandHostTime>;
+
+} // namespace protocol
+
+#endif // PROTOCOL_H
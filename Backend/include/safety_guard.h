@@ -0,0 +1,70 @@
+#ifndef SAFETY_GUARD_H
+#define SAFETY_GUARD_H
+
+#include <atomic>
+#include <cstdint>
+
+// 指令安全限制，<= 0 或上下限相等表示关闭该项检查
+struct SafetyLimits {
+    float maxTorque = 0.0f;         // 力矩幅值上限（Nm）
+    float maxSlewRate = 0.0f;       // 力矩变化率上限（Nm/s）
+    float minAngle = 0.0f;          // 位置包络（度，展开后的多圈位置），越界后向外的力矩立即切断（不经变化率限制）
+    float maxAngle = 0.0f;
+    float feedbackTimeout = 0.1f;   // 反馈看门狗（秒），超时输出零力矩
+};
+
+// 各项检查的触发次数：条件从不成立变为成立时计一次，持续成立期间不重复计数
+struct SafetyStats {
+    uint64_t feedbackTimeouts = 0;
+    uint64_t torqueClamps = 0;
+    uint64_t slewClamps = 0;
+    uint64_t envelopeTrips = 0;
+    uint64_t emergencyStops = 0;
+};
+
+// 发送路径上的安全层：每个指令包调用一次 apply，全部为常数时间的比较与限幅，
+// 限制参数以原子量保存，运行中可由其他线程修改
+class SafetyGuard {
+public:
+    SafetyGuard();
+
+    void setLimits(const SafetyLimits& limits);
+    [[nodiscard]] SafetyLimits limits() const;
+    [[nodiscard]] SafetyStats stats() const;
+
+    // 由发送线程调用：torque 为请求力矩，position 为展开后的多圈位置（度），
+    // feedbackAgeNs 为距最近一次反馈的时间（从未收到反馈时传负数），nowNs 为当前时刻
+    float apply(float torque, double position, int64_t feedbackAgeNs, int64_t nowNs);
+
+    // 全局急停：锁存，所有电机在下一个发送周期输出零力矩，直到显式解除
+    static void emergencyStop();
+    static void clearEmergencyStop();
+    static bool isEmergencyStopped();
+
+private:
+    std::atomic<float> maxTorque;
+    std::atomic<float> maxSlewRate;
+    std::atomic<float> minAngle;
+    std::atomic<float> maxAngle;
+    std::atomic<int64_t> feedbackTimeoutNs;
+
+    std::atomic<uint64_t> feedbackTimeouts;
+    std::atomic<uint64_t> torqueClamps;
+    std::atomic<uint64_t> slewClamps;
+    std::atomic<uint64_t> envelopeTrips;
+    std::atomic<uint64_t> emergencyStops;
+
+    // 仅发送线程访问
+    float lastOutput;
+    int64_t lastNs;
+    // 上一包时各项检查是否处于触发状态，用于只在上升沿计数
+    bool emergencyStopActive;
+    bool feedbackTimeoutActive;
+    bool torqueClampActive;
+    bool slewClampActive;
+    bool envelopeActive;
+
+    static std::atomic<bool> estop;
+};
+
+#endif // SAFETY_GUARD_H
@@ -0,0 +1,36 @@
+#ifndef SERIAL_TRANSPORT_H
+#define SERIAL_TRANSPORT_H
+
+#include "transport.h"
+
+// 串口（UART / USB 转串口）传输层，基于 termios，仅支持类 Unix 平台
+class SerialTransport : public Transport {
+public:
+    struct Options {
+        int baudRate = 921600;
+        int vmin = 1;            // 阻塞读时至少返回的字节数
+        int vtime = 0;           // 阻塞读的字节间超时（0.1 秒为单位）
+        bool lowLatency = true;  // 请求驱动关闭接收 FIFO 延时（ASYNC_LOW_LATENCY）
+        bool nonBlocking = true; // 非阻塞模式：读写均由 poll 驱动
+    };
+
+    explicit SerialTransport(std::string device);
+    SerialTransport(std::string device, const Options& options);
+    ~SerialTransport() override;
+
+    bool open() override;
+    void close() override;
+    [[nodiscard]] bool isOpen() const override;
+
+    bool send(const uint8_t* data, size_t size) override;
+    int receive(uint8_t* data, size_t size, int timeoutMs) override;
+
+    [[nodiscard]] std::string describe() const override;
+
+private:
+    std::string device;
+    Options options;
+    int fd;
+};
+
+#endif // SERIAL_TRANSPORT_H
@@ -0,0 +1,63 @@
+#ifndef SHM_TRANSPORT_H
+#define SHM_TRANSPORT_H
+
+#include "transport.h"
+#include <atomic>
+
+struct ShmSegment;
+
+// 共享内存传输层，用于与仿真端运行在同一台机器上的场景：省去 TCP 回环每个小包的内核拷贝与唤醒。
+// 一个 POSIX 共享内存段（shm_open）内放两个单生产者单消费者字节环：指令环（上位机 → 设备）
+// 与反馈环（设备 → 上位机），承载与 TCP 完全相同的指令 / 反馈字节流，组帧不变。
+// 接收方先自旋 spinUs 微秒，仍无数据则在环的序号上 futex 等待（Linux，其他类 Unix 平台退化为短休眠）；
+// busyPoll 时一直自旋不睡眠，往返最短但独占一个核。
+// 先打开的一方创建并初始化共享内存段，关闭时由创建方 shm_unlink；任一方关闭后对方 receive 返回 -1。
+// 段内记录双方进程号：对方进程已退出（崩溃、被杀）时同样在约 100 ms 内返回 -1；打开时若已有的段
+// 没有存活的使用者（上次运行的进程崩溃后遗留），先删除再重新创建，不会接上旧的环。双方须在同一 PID 命名空间。
+// 仅支持类 Unix 平台；Windows 上 open 返回 false。仓库中的 Unity 仿真端没有实现共享内存，
+// 设备端需要是链接 controlry_core 并以 Role::DEVICE 打开的 C++ 进程（参见 bench/transport_bench.cpp）
+class ShmTransport : public Transport {
+public:
+    enum class Role {
+        CONTROLLER,  // 上位机：写指令环、读反馈环
+        DEVICE       // 仿真端 / 设备：写反馈环、读指令环
+    };
+
+    struct Options {
+        Role role = Role::CONTROLLER;
+        size_t capacity = 4096;  // 每个环的字节数，向上取整为 2 的幂；仅创建方生效
+        int spinUs = 0;          // futex 等待前的自旋时间（微秒）
+        bool busyPoll = false;   // 一直自旋，不进入 futex 等待
+        int attachTimeoutMs = 1000;  // 打开已存在的段时等待创建方完成初始化的时间
+    };
+
+    // name 为共享内存段名，不带前导 '/' 时自动补上
+    explicit ShmTransport(std::string name);
+    ShmTransport(std::string name, const Options& options);
+    ~ShmTransport() override;
+
+    bool open() override;
+    void close() override;
+    [[nodiscard]] bool isOpen() const override;
+
+    // 环中空间不足时等待对方消费，100 ms 内仍不足返回 false；对方尚未连上时丢弃数据并返回 true
+    bool send(const uint8_t* data, size_t size) override;
+    int receive(uint8_t* data, size_t size, int timeoutMs) override;
+
+    [[nodiscard]] std::string describe() const override;
+
+private:
+    // 打开一次；已有的段无人使用时置 stale 并返回 false，由 open 删除后重试
+    bool openSegment(bool& stale);
+    // 对方仍在（或尚未连上）时返回 true；按固定间隔检查对方进程是否存活
+    bool peerAlive();
+
+    std::string name;
+    Options options;
+    ShmSegment* segment;
+    size_t mappedSize;
+    bool created;
+    std::atomic<int64_t> nextLivenessCheckNs;
+};
+
+#endif // SHM_TRANSPORT_H
@@ -0,0 +1,118 @@
+#ifndef SOCKET_COMPAT_H
+#define SOCKET_COMPAT_H
+
+// Winsock / BSD socket 差异的最小封装
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+using socket_t = SOCKET;
+using pollfd_t = WSAPOLLFD;
+constexpr socket_t INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+constexpr int SOCKET_SEND_FLAGS = 0;
+
+inline int closeSocket(socket_t sock) {
+    return closesocket(sock);
+}
+
+inline int pollSockets(pollfd_t* fds, unsigned long count, int timeoutMs) {
+    return WSAPoll(fds, count, timeoutMs);
+}
+
+inline bool setSocketNonBlocking(socket_t sock, bool enable) {
+    u_long mode = enable ? 1 : 0;
+    return ioctlsocket(sock, FIONBIO, &mode) == 0;
+}
+
+inline int lastSocketError() {
+    return WSAGetLastError();
+}
+
+inline bool socketWouldBlock(int error) {
+    return error == WSAEWOULDBLOCK;
+}
+
+// UDP 对端未就绪时 ICMP 端口不可达导致的错误，属于暂时状态
+inline bool socketPeerUnreachable(int error) {
+    return error == WSAECONNRESET || error == WSAECONNREFUSED;
+}
+
+inline bool initializeSockets() {
+    static bool initialized = false;
+    if (!initialized) {
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+            return false;
+        }
+        initialized = true;
+    }
+    return true;
+}
+
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using socket_t = int;
+using pollfd_t = pollfd;
+constexpr socket_t INVALID_SOCKET_HANDLE = -1;
+// 对端关闭后 send 不触发 SIGPIPE
+#ifdef MSG_NOSIGNAL
+constexpr int SOCKET_SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SOCKET_SEND_FLAGS = 0;
+#endif
+
+inline int closeSocket(socket_t sock) {
+    return ::close(sock);
+}
+
+inline int pollSockets(pollfd_t* fds, unsigned long count, int timeoutMs) {
+    return ::poll(fds, static_cast<nfds_t>(count), timeoutMs);
+}
+
+inline bool setSocketNonBlocking(socket_t sock, bool enable) {
+    const int flags = fcntl(sock, F_GETFL, 0);
+    if (flags < 0) {
+        return false;
+    }
+    return fcntl(sock, F_SETFL, enable ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK)) == 0;
+}
+
+inline int lastSocketError() {
+    return errno;
+}
+
+inline bool socketWouldBlock(int error) {
+    return error == EAGAIN || error == EWOULDBLOCK || error == EINTR;
+}
+
+// UDP 对端未就绪时 ICMP 端口不可达导致的错误，属于暂时状态
+inline bool socketPeerUnreachable(int error) {
+    return error == ECONNREFUSED;
+}
+
+inline bool initializeSockets() {
+    return true;
+}
+
+#endif
+
+struct TransportOptions;
+
+// 按选项配置 socket（须在 connect 之前调用，缓冲区大小影响窗口协商），
+// stream 为 true 时额外应用 TCP 专属选项；非阻塞模式由传输层在连接建立后设置。
+// 单项失败只打印警告（如 SO_BUSY_POLL 需要权限），返回是否全部生效
+bool applySocketOptions(socket_t sock, const TransportOptions& options, bool stream);
+
+// TCP_QUICKACK 不是持久选项，每次接收后调用
+void refreshQuickAck(socket_t sock);
+
+#endif // SOCKET_COMPAT_H
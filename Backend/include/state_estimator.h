@@ -0,0 +1,78 @@
+#ifndef STATE_ESTIMATOR_H
+#define STATE_ESTIMATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 估计器噪声参数（均为标准差，jerkDensity 为加加速度白噪声的功率谱密度）
+struct EstimatorConfig {
+    float angleNoise = 0.05f;     // 角度测量噪声（度）
+    float omegaNoise = 0.05f;     // 角速度测量噪声（rad/s）
+    float jerkDensity = 1.0e5f;   // 过程噪声（rad²/s⁵），越大跟踪越快、滤波越弱
+};
+
+// 估计结果，角度为展开后的多圈位置
+struct EstimatedState {
+    double angle = 0.0;           // 度
+    float omega = 0.0f;           // rad/s
+    float acceleration = 0.0f;    // rad/s²
+    int64_t timeNs = 0;           // 对应的上位机 steady_clock 时刻，0 表示尚未初始化
+};
+
+// 常加速度模型的卡尔曼滤波：状态 [角度, 角速度, 角加速度]，同时观测角度与角速度。
+// 角度观测为 AngleTracker 展开后的多圈位置，滤波本身不处理回绕。
+// 观测噪声互不相关，逐个做标量更新，不需要矩阵求逆
+class StateEstimator {
+public:
+    StateEstimator();
+    explicit StateEstimator(const EstimatorConfig& config);
+
+    void setConfig(const EstimatorConfig& config);
+    void reset();
+
+    // 每帧反馈调用一次，positionDeg 为展开后的位置，timeNs 为采样时刻
+    void update(double positionDeg, float omega, int64_t timeNs);
+
+    [[nodiscard]] const EstimatedState& state() const;
+    [[nodiscard]] bool initialized() const;
+
+    // 按常加速度模型外推到 timeNs，外推时长限制在 maxHorizon 秒以内
+    static EstimatedState extrapolate(const EstimatedState& state, int64_t timeNs, float maxHorizon = 0.05f);
+
+private:
+    EstimatorConfig config;
+    EstimatedState current;
+
+    // 状态以弧度保存，角度用 double 避免多圈后精度下降
+    double position;
+    float velocity;
+    float accel;
+    float covariance[6];  // 对称阵上三角：P00 P01 P02 P11 P12 P22
+};
+
+// 多电机批量估计（SoA 布局）：所有电机共享同一 dt，各分量按数组连续存放以便编译器向量化，
+// 用于控制周期内统一对全部电机做预测 / 更新
+class StateEstimatorBank {
+public:
+    explicit StateEstimatorBank(size_t count);
+    StateEstimatorBank(size_t count, const EstimatorConfig& config);
+
+    // positionDeg（展开后的位置）/ omega 各含 size() 个测量，首次调用时用测量值初始化
+    void update(const double* positionDeg, const float* omega, float dt);
+    // 外推 dt 秒后的角度（度）与角速度，不修改内部状态
+    void predict(float dt, double* angleDeg, float* omega) const;
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] EstimatedState state(size_t index) const;
+
+private:
+    EstimatorConfig config;
+    bool initialized;
+    std::vector<double> position;
+    std::vector<float> velocity;
+    std::vector<float> accel;
+    std::vector<float> p00, p01, p02, p11, p12, p22;
+};
+
+#endif // STATE_ESTIMATOR_H
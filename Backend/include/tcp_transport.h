@@ -0,0 +1,28 @@
+#ifndef TCP_TRANSPORT_H
+#define TCP_TRANSPORT_H
+
+#include "transport.h"
+#include "socket_compat.h"
+
+class TcpTransport : public Transport {
+public:
+    TcpTransport(std::string ipAddress, int port, const TransportOptions& options = TransportOptions{});
+    ~TcpTransport() override;
+
+    bool open() override;
+    void close() override;
+    [[nodiscard]] bool isOpen() const override;
+
+    bool send(const uint8_t* data, size_t size) override;
+    int receive(uint8_t* data, size_t size, int timeoutMs) override;
+
+    [[nodiscard]] std::string describe() const override;
+
+private:
+    std::string ipAddress;
+    int port;
+    TransportOptions options;
+    socket_t sock;
+};
+
+#endif // TCP_TRANSPORT_H
@@ -0,0 +1,66 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "protocol.h"
+
+// 链路统计（由发送 / 接收线程更新，读取为快照）
+struct TransportStats {
+    uint64_t packetsSent = 0;
+    uint64_t packetsReceived = 0;
+    uint64_t packetsLost = 0;       // 序号跳变推断出的丢包数
+    uint64_t packetsReordered = 0;  // 迟到（序号落后）而被丢弃的包
+    uint64_t packetsDuplicated = 0;
+    uint64_t packetsSuperseded = 0; // 同一次读取中被更新序号覆盖的包（最新者优先）
+    uint64_t checksumErrors = 0;
+};
+
+// 每个连接的 socket 调优选项，串口传输层忽略
+struct TransportOptions {
+    bool tcpNoDelay = true;     // TCP_NODELAY：关闭 Nagle，7 字节指令包立即发出
+    bool quickAck = false;      // TCP_QUICKACK：每次接收后立即回 ACK（Linux，需每次 recv 后重新设置）
+    bool nonBlocking = false;   // 非阻塞 socket，收发均由 poll 驱动
+    int sendBufferSize = 0;     // SO_SNDBUF（字节），0 使用系统默认；调小可避免排队过期指令
+    int receiveBufferSize = 0;  // SO_RCVBUF（字节），0 使用系统默认
+    int busyPollUs = 0;         // SO_BUSY_POLL（微秒，Linux），0 关闭
+    int priority = -1;          // SO_PRIORITY（0~6，Linux），-1 不设置
+};
+
+// 字节流传输层抽象，MotorCommunication 只通过此接口收发，
+// 协议组帧（FeedbackFramer）与具体链路（TCP / 串口 / 共享内存）无关
+class Transport {
+public:
+    virtual ~Transport() = default;
+
+    virtual bool open() = 0;
+    virtual void close() = 0;
+    [[nodiscard]] virtual bool isOpen() const = 0;
+
+    // 发送全部数据，失败返回 false
+    virtual bool send(const uint8_t* data, size_t size) = 0;
+
+    // 最多等待 timeoutMs 毫秒：返回读到的字节数，超时返回 0，链路断开或出错返回 -1
+    virtual int receive(uint8_t* data, size_t size, int timeoutMs) = 0;
+
+    // 用于日志输出的链路描述
+    [[nodiscard]] virtual std::string describe() const = 0;
+
+    // 链路层统计，不区分包的传输层（TCP / 串口）返回空统计
+    [[nodiscard]] virtual TransportStats stats() const { return {}; }
+};
+
+// 按 URI 创建传输层（未打开）：
+//   tcp://127.0.0.1:6000?nodelay=1&quickack=1&sndbuf=4096&rcvbuf=4096&busypoll=50&priority=6&nonblock=1
+//   udp://127.0.0.1:6000（同样支持 socket 选项）
+//   serial:///dev/ttyUSB0?baud=921600&vmin=1&vtime=0&lowlatency=1
+//   shm://controlry-motor0?role=controller|device&spin=20&busypoll=1&capacity=4096（同机共享内存）
+std::unique_ptr<Transport> createTransport(const std::string& uri);
+
+// 解析 URI 中与链路无关的协议参数：protocol=1|2、crc=16|32c、stamp=0|1，
+// 未出现的参数保持 options 原值；URI 含任一协议参数时返回 true
+bool parseProtocolOptions(const std::string& uri, ProtocolOptions& options);
+
+#endif // TRANSPORT_H
@@ -0,0 +1,58 @@
+#ifndef UDP_TRANSPORT_H
+#define UDP_TRANSPORT_H
+
+#include "transport.h"
+#include "socket_compat.h"
+#include <atomic>
+
+// UDP 传输层：每个数据报 = 4 字节小端序号 + 原协议包（A1 指令 / A0 反馈）
+// 接收端按序号检测丢包、乱序与重复，一次读取中只交付序号最新的数据报，
+// 过期的力矩 / 反馈直接丢弃而不是重传。数据报载荷大于调用方缓冲区时，
+// 剩余部分留到下一次 receive 交付，不会被截断
+class UdpTransport : public Transport {
+public:
+    static constexpr size_t SEQUENCE_SIZE = 4;
+    static constexpr size_t MAX_DATAGRAM = 512;
+    // 序号回退超过该值视为对端重新打开（双方每次打开都从 0 计数），重新开始跟踪而不是当作乱序丢弃
+    static constexpr int32_t RESTART_WINDOW = 1024;
+
+    UdpTransport(std::string ipAddress, int port, const TransportOptions& options = TransportOptions{});
+    ~UdpTransport() override;
+
+    bool open() override;
+    void close() override;
+    [[nodiscard]] bool isOpen() const override;
+
+    bool send(const uint8_t* data, size_t size) override;
+    int receive(uint8_t* data, size_t size, int timeoutMs) override;
+
+    [[nodiscard]] std::string describe() const override;
+    [[nodiscard]] TransportStats stats() const override;
+
+private:
+    // 按序号判定是否接收该数据报，并更新统计
+    bool acceptSequence(uint32_t sequence);
+
+    std::string ipAddress;
+    int port;
+    TransportOptions options;
+    socket_t sock;
+
+    uint32_t sendSequence;
+    uint32_t lastReceivedSequence;
+    bool hasReceived;
+
+    // 最新数据报中尚未交付的载荷
+    uint8_t pending[MAX_DATAGRAM];
+    size_t pendingOffset;
+    size_t pendingSize;
+
+    std::atomic<uint64_t> sent;
+    std::atomic<uint64_t> received;
+    std::atomic<uint64_t> lost;
+    std::atomic<uint64_t> reordered;
+    std::atomic<uint64_t> duplicated;
+    std::atomic<uint64_t> superseded;
+};
+
+#endif // UDP_TRANSPORT_H
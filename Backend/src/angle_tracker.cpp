@@ -0,0 +1,45 @@
+#include "angle_tracker.h"
+
+AngleTracker::AngleTracker() {
+    reset();
+}
+
+void AngleTracker::reset() {
+    hasSample = false;
+    turnCount = 0;
+    withinTurn = 0.0f;
+}
+
+double AngleTracker::update(float wrappedDeg) {
+    const float current = angle::wrap360(wrappedDeg);
+    if (!hasSample) {
+        hasSample = true;
+        turnCount = static_cast<int64_t>(std::floor(static_cast<double>(wrappedDeg) / 360.0));
+    } else {
+        // 圈内角度跳变超过半圈说明越过了 0° / 360°
+        const float jump = current - withinTurn;
+        if (jump < -180.0f) {
+            ++turnCount;
+        } else if (jump >= 180.0f) {
+            --turnCount;
+        }
+    }
+    withinTurn = current;
+    return position();
+}
+
+double AngleTracker::position() const {
+    return static_cast<double>(turnCount) * 360.0 + withinTurn;
+}
+
+int64_t AngleTracker::turns() const {
+    return turnCount;
+}
+
+float AngleTracker::angleInTurn() const {
+    return withinTurn;
+}
+
+bool AngleTracker::initialized() const {
+    return hasSample;
+}
@@ -0,0 +1,125 @@
+#include "clock_sync.h"
+#include <cmath>
+#include <limits>
+
+ClockSync::ClockSync() : ClockSync(Options{}) {
+}
+
+ClockSync::ClockSync(const Options& options) : options(options) {
+    reset();
+}
+
+void ClockSync::reset() {
+    current = Estimate{};
+    hasDeviceTime = false;
+    lastDeviceUs = 0;
+    deviceEpochUs = 0;
+    windowCount = 0;
+    bestDelay = std::numeric_limits<double>::infinity();
+    bestDeviceNs = 0.0;
+    bestOffsetNs = 0.0;
+    bestRttNs = 0.0;
+    referenceDeviceNs = 0.0;
+    referenceOffsetNs = 0.0;
+    sumW = sumX = sumY = sumXX = sumXY = 0.0;
+    interceptNs = 0.0;
+    slope = 0.0;
+}
+
+int64_t ClockSync::unwrap(uint32_t deviceTimeUs) const {
+    // 与最近样本的差按有符号 32 位解释，前后约 35 分钟内都能正确展开
+    const int32_t delta = static_cast<int32_t>(deviceTimeUs - lastDeviceUs);
+    return deviceEpochUs + static_cast<int64_t>(lastDeviceUs) + delta;
+}
+
+bool ClockSync::addSample(int64_t hostSendNs, uint32_t deviceTimeUs, int64_t hostReceiveNs) {
+    if (!hasDeviceTime) {
+        hasDeviceTime = true;
+        lastDeviceUs = deviceTimeUs;
+    }
+    const int64_t deviceUs = unwrap(deviceTimeUs);
+    deviceEpochUs = deviceUs - deviceTimeUs;
+    lastDeviceUs = deviceTimeUs;
+
+    const double deviceNs = static_cast<double>(deviceUs) * 1e3;
+    const bool roundTrip = hostSendNs >= 0 && hostSendNs <= hostReceiveNs;
+
+    double offset;
+    double delay;
+    double rtt = 0.0;
+    if (roundTrip) {
+        rtt = static_cast<double>(hostReceiveNs - hostSendNs);
+        offset = 0.5 * (static_cast<double>(hostSendNs) + static_cast<double>(hostReceiveNs)) - deviceNs;
+        delay = rtt;
+    } else {
+        offset = static_cast<double>(hostReceiveNs) - deviceNs;
+        delay = offset;  // 单向模式下 offset 越小说明传输时延越小
+    }
+
+    if (delay < bestDelay) {
+        bestDelay = delay;
+        bestDeviceNs = deviceNs;
+        bestOffsetNs = offset;
+        bestRttNs = rtt;
+    }
+
+    if (++windowCount < options.window) {
+        return false;
+    }
+
+    addSyncPoint(bestDeviceNs, bestOffsetNs, bestRttNs);
+    windowCount = 0;
+    bestDelay = std::numeric_limits<double>::infinity();
+    return true;
+}
+
+void ClockSync::addSyncPoint(double deviceNs, double offsetNs, double rttNs) {
+    if (current.syncPoints == 0) {
+        referenceDeviceNs = deviceNs;
+        referenceOffsetNs = offsetNs;
+    }
+
+    const double x = (deviceNs - referenceDeviceNs) * 1e-9;
+    const double y = offsetNs - referenceOffsetNs;
+    const double lambda = options.forgetting;
+    sumW = lambda * sumW + 1.0;
+    sumX = lambda * sumX + x;
+    sumY = lambda * sumY + y;
+    sumXX = lambda * sumXX + x * x;
+    sumXY = lambda * sumXY + x * y;
+
+    // 同步点跨度太短时偏移抖动会被当作漂移，只估计偏移；
+    // 均匀分布在跨度 L 上的点方差为 L² / 12
+    const double det = sumW * sumXX - sumX * sumX;
+    const double variance = det / (sumW * sumW);
+    if (variance > options.minDriftSpan * options.minDriftSpan / 12.0) {
+        slope = (sumW * sumXY - sumX * sumY) / det;
+        interceptNs = (sumY - slope * sumX) / sumW;
+    } else {
+        slope = 0.0;
+        interceptNs = sumY / sumW;
+    }
+
+    ++current.syncPoints;
+    current.synchronized = true;
+    current.offsetNs = offsetAt(deviceNs);
+    // 偏移每秒减少 1 us 即设备时钟快 1 ppm（ns/s -> ppm）
+    current.driftPpm = -slope * 1e-3;
+    current.rttNs = rttNs;
+}
+
+double ClockSync::offsetAt(double deviceNs) const {
+    return referenceOffsetNs + interceptNs + slope * (deviceNs - referenceDeviceNs) * 1e-9;
+}
+
+int64_t ClockSync::toHost(uint32_t deviceTimeUs) const {
+    if (!current.synchronized) {
+        return -1;
+    }
+    const double deviceNs = static_cast<double>(unwrap(deviceTimeUs)) * 1e3;
+    return static_cast<int64_t>(std::llround(deviceNs + offsetAt(deviceNs)));
+}
+
+const ClockSync::Estimate& ClockSync::estimate() const {
+    return current;
+}
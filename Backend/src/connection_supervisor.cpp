@@ -0,0 +1,196 @@
+#include "connection_supervisor.h"
+#include "motor_com.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+ConnectionSupervisor::ConnectionSupervisor() :
+    running(false),
+    reconnectCount(0),
+    rng(std::random_device{}()) {
+}
+
+ConnectionSupervisor::~ConnectionSupervisor() {
+    stop();
+}
+
+void ConnectionSupervisor::watch(Motor* motor) {
+    if (!motor) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& entry : entries) {
+        if (entry.motor == motor) {
+            return;
+        }
+    }
+    Entry entry;
+    entry.motor = motor;
+    // 加入监管前已收到的反馈同样有效
+    const int64_t lastFeedback = motor->lastFeedbackNs.load(std::memory_order_acquire);
+    entry.connectedNs = lastFeedback > 0 ? lastFeedback - 1 : Motor::steadyNowNs();
+    entries.push_back(std::move(entry));
+}
+
+void ConnectionSupervisor::unwatch(int motorId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = std::find_if(entries.begin(), entries.end(),
+                           [motorId](const Entry& entry) { return entry.motor->getMotorId() == motorId; });
+    if (it == entries.end()) {
+        return;
+    }
+    if (it->pending.valid()) {
+        it->pending.wait();
+    }
+    it->motor->setHoldZeroTorque(false);
+    entries.erase(it);
+}
+
+void ConnectionSupervisor::start() {
+    start(Config{});
+}
+
+void ConnectionSupervisor::start(const Config& newConfig) {
+    if (running) {
+        return;
+    }
+    config = newConfig;
+    running = true;
+    thread = std::thread(&ConnectionSupervisor::run, this);
+}
+
+void ConnectionSupervisor::stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& entry : entries) {
+        if (entry.pending.valid()) {
+            entry.pending.wait();
+        }
+    }
+}
+
+bool ConnectionSupervisor::isRunning() const {
+    return running;
+}
+
+uint64_t ConnectionSupervisor::reconnects() const {
+    return reconnectCount.load(std::memory_order_relaxed);
+}
+
+void ConnectionSupervisor::run() {
+    profiler::setThreadName("supervisor");
+    while (running) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto now = Clock::now();
+            for (auto& entry : entries) {
+                supervise(entry, now);
+            }
+        }
+        std::this_thread::sleep_for(config.period);
+    }
+}
+
+void ConnectionSupervisor::supervise(Entry& entry, Clock::time_point now) {
+    Motor* motor = entry.motor;
+
+    // 重连在后台进行，阻塞的 connect 不会拖慢其他电机的监管
+    if (entry.pending.valid()) {
+        if (entry.pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return;
+        }
+        const bool reconnected = entry.pending.get();
+        if (motor->disconnectRequested.load()) {
+            // 重连期间用户主动断开：不计入重连，也不退避
+            entry.attempts = 0;
+        } else if (reconnected) {
+            entry.connectedNs = Motor::steadyNowNs();
+            reconnectCount.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            entry.nextAttempt = now + backoff(entry.attempts++);
+            motor->linkState.store(LinkState::BACKOFF);
+        }
+        return;
+    }
+
+    if (motor->disconnectRequested.load()) {
+        // 用户主动断开，不重连；重新连接后的反馈以此刻为起点判断新鲜度
+        entry.attempts = 0;
+        entry.nextAttempt = now;
+        entry.connectedNs = Motor::steadyNowNs();
+        motor->linkState.store(LinkState::DISCONNECTED);
+        return;
+    }
+
+    if (!motor->isConnected()) {
+        motor->setHoldZeroTorque(true);
+        if (now >= entry.nextAttempt) {
+            motor->linkState.store(LinkState::CONNECTING);
+            launchReconnect(entry);
+        } else {
+            motor->linkState.store(LinkState::BACKOFF);
+        }
+        return;
+    }
+
+    const int64_t nowNs = Motor::steadyNowNs();
+    const int64_t lastFeedback = motor->lastFeedbackNs.load(std::memory_order_acquire);
+    const int64_t timeoutNs = std::chrono::duration_cast<std::chrono::nanoseconds>(config.feedbackTimeout).count();
+    const bool fresh = lastFeedback > entry.connectedNs;
+
+    if (fresh && nowNs - lastFeedback < timeoutNs) {
+        // 连接后收到第一帧新反馈才恢复力矩输出，控制器此时拿到的是有效状态
+        entry.attempts = 0;
+        motor->setHoldZeroTorque(false);
+        motor->linkState.store(LinkState::UP);
+        return;
+    }
+
+    motor->setHoldZeroTorque(true);
+    if (nowNs - std::max(lastFeedback, entry.connectedNs) < timeoutNs) {
+        // 刚建立连接，等待第一帧反馈
+        motor->linkState.store(LinkState::CONNECTING);
+        return;
+    }
+
+    // 已连接但反馈中断：对端可能已重启而 TCP 尚未察觉，主动重连；
+    // 对端能接受连接却始终不回反馈时同样按退避间隔重试
+    motor->linkState.store(LinkState::STALE);
+    if (now < entry.nextAttempt) {
+        return;
+    }
+    std::cerr << "Motor ID " << motor->getMotorId() << " - Feedback timeout, reconnecting." << std::endl;
+    entry.nextAttempt = now + backoff(entry.attempts++);
+    launchReconnect(entry);
+}
+
+void ConnectionSupervisor::launchReconnect(Entry& entry) {
+    Motor* motor = entry.motor;
+    entry.pending = std::async(std::launch::async, [motor]() {
+        // 不走 Motor::reconnect：那是用户接口，会清除主动断开的标记
+        if (motor->disconnectRequested.load() || !motor->communication->reconnect()) {
+            return false;
+        }
+        if (motor->disconnectRequested.load()) {
+            // 与用户的 disconnect 交错：断开在重连之前执行时撤销这次重连
+            motor->communication->disconnect();
+            return false;
+        }
+        return true;
+    });
+}
+
+std::chrono::milliseconds ConnectionSupervisor::backoff(int attempts) {
+    const double base = static_cast<double>(config.initialBackoff.count()) * std::pow(2.0, std::min(attempts, 16));
+    const double capped = std::min(base, static_cast<double>(config.maxBackoff.count()));
+    std::uniform_real_distribution<double> dist(1.0 - config.jitter, 1.0 + config.jitter);
+    return std::chrono::milliseconds(static_cast<int64_t>(capped * dist(rng)));
+}
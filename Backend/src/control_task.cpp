@@ -0,0 +1,158 @@
+#include "control_task.h"
+#include <iostream>
+
+ControlScheduler::ControlScheduler() :
+    nowNs(0),
+    tickCount(0),
+    cancelAllRequested(false),
+    hasPending(false),
+    nextId(1),
+    count(0) {
+}
+
+ControlScheduler::~ControlScheduler() {
+    // 销毁根任务的协程帧时，挂起中的子任务随父任务的局部对象一起销毁
+    for (const Entry& entry : tasks) {
+        entry.handle.destroy();
+    }
+    for (const Entry& entry : pending) {
+        entry.handle.destroy();
+    }
+}
+
+ControlScheduler::TaskId ControlScheduler::spawn(ControlTask task) {
+    if (!task.valid()) {
+        return 0;
+    }
+    const TaskId id = nextId.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pending.push_back({id, std::exchange(task.handle, {})});
+    }
+    count.fetch_add(1, std::memory_order_relaxed);
+    hasPending.store(true, std::memory_order_release);
+    return id;
+}
+
+void ControlScheduler::cancel(TaskId id) {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    cancelled.push_back(id);
+    hasPending.store(true, std::memory_order_release);
+}
+
+void ControlScheduler::cancelAll() {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    cancelAllRequested = true;
+    hasPending.store(true, std::memory_order_release);
+}
+
+void ControlScheduler::adoptPending() {
+    std::vector<Entry> adopted;
+    std::vector<TaskId> toCancel;
+    bool all;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        adopted.swap(pending);
+        toCancel.swap(cancelled);
+        all = std::exchange(cancelAllRequested, false);
+    }
+
+    for (const Entry& entry : adopted) {
+        ControlTask::promise_type& promise = entry.handle.promise();
+        promise.scheduler = this;
+        promise.leaf = entry.handle;
+        promise.wait = ControlTask::Wait::START;
+        tasks.push_back(entry);
+    }
+
+    if (!all && toCancel.empty()) {
+        return;
+    }
+    size_t kept = 0;
+    for (const Entry& entry : tasks) {
+        bool drop = all;
+        for (TaskId id : toCancel) {
+            drop = drop || entry.id == id;
+        }
+        if (drop) {
+            entry.handle.destroy();
+            count.fetch_sub(1, std::memory_order_relaxed);
+        } else {
+            tasks[kept++] = entry;
+        }
+    }
+    tasks.resize(kept);
+}
+
+bool ControlScheduler::ready(ControlTask::promise_type& promise, int64_t nowNs) {
+    switch (promise.wait) {
+        case ControlTask::Wait::START:
+        case ControlTask::Wait::TICK:
+            return true;
+        case ControlTask::Wait::TIME:
+            return nowNs >= promise.wakeNs;
+        case ControlTask::Wait::CONDITION:
+            if (promise.condition(promise.conditionContext)) {
+                promise.conditionMet = true;
+                return true;
+            }
+            if (nowNs >= promise.wakeNs) {
+                promise.conditionMet = false;
+                return true;
+            }
+            return false;
+    }
+    return false;
+}
+
+void ControlScheduler::finish(const Entry& entry) {
+    const std::exception_ptr error = entry.handle.promise().error;
+    if (error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::exception& e) {
+            std::cerr << "Control task " << entry.id << " failed: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "Control task " << entry.id << " failed with unknown exception" << std::endl;
+        }
+    }
+    entry.handle.destroy();
+    count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ControlScheduler::tick(int64_t timeNs) {
+    nowNs = timeNs;
+    ++tickCount;
+    if (hasPending.exchange(false, std::memory_order_acquire)) {
+        adoptPending();
+    }
+
+    // 本周期内 spawn 的任务进入 pending，不会改变 tasks，按下标遍历并原地压缩
+    size_t kept = 0;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        const Entry entry = tasks[i];
+        ControlTask::promise_type& promise = entry.handle.promise();
+        if (ready(promise, nowNs)) {
+            promise.wait = ControlTask::Wait::TICK;
+            promise.leaf.resume();
+            if (entry.handle.done()) {
+                finish(entry);
+                continue;
+            }
+        }
+        tasks[kept++] = entry;
+    }
+    tasks.resize(kept);
+}
+
+int64_t ControlScheduler::now() const {
+    return nowNs;
+}
+
+uint64_t ControlScheduler::ticks() const {
+    return tickCount;
+}
+
+size_t ControlScheduler::size() const {
+    return count.load(std::memory_order_relaxed);
+}
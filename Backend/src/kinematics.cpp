@@ -0,0 +1,123 @@
+#include "kinematics.h"
+#include <algorithm>
+
+namespace {
+
+constexpr float PI = 3.14159265358979323846f;
+constexpr float TWO_PI = 2.0f * PI;
+constexpr float HALF_PI = 0.5f * PI;
+// 模块速度低于该值（rad/s）视为静止，保持当前朝向
+constexpr float MIN_MODULE_SPEED = 1e-4f;
+
+LinearKinematics<4>::Matrix mecanumMatrix(float r, float halfLength, float halfWidth) {
+    const float k = halfLength + halfWidth;
+    return {{{1.0f / r, -1.0f / r, -k / r},
+             {1.0f / r, 1.0f / r, k / r},
+             {1.0f / r, 1.0f / r, -k / r},
+             {1.0f / r, -1.0f / r, k / r}}};
+}
+
+LinearKinematics<8>::Matrix swerveMatrix(const SwerveKinematics::Positions& positions) {
+    LinearKinematics<8>::Matrix matrix{};
+    for (size_t i = 0; i < SwerveKinematics::MODULES; ++i) {
+        matrix[2 * i] = {1.0f, 0.0f, -positions[i][1]};
+        matrix[2 * i + 1] = {0.0f, 1.0f, positions[i][0]};
+    }
+    return matrix;
+}
+
+} // namespace
+
+MecanumKinematics::MecanumKinematics(float wheelRadius, float halfLength, float halfWidth) :
+    LinearKinematics<4>(mecanumMatrix(wheelRadius, halfLength, halfWidth)) {
+}
+
+SwerveKinematics::SwerveKinematics(float wheelRadius, const Positions& positions) :
+    radius(wheelRadius),
+    positions(positions),
+    components(swerveMatrix(positions)) {
+}
+
+void SwerveKinematics::inverse(const BodyTwist& twist, const float* currentSteer, ModuleState* modules) const {
+    float c[2 * MODULES];
+    components.inverse(twist, c);
+    for (size_t i = 0; i < MODULES; ++i) {
+        float speed = std::hypot(c[2 * i], c[2 * i + 1]) / radius;
+        if (speed < MIN_MODULE_SPEED) {
+            modules[i] = {currentSteer[i], 0.0f};
+            continue;
+        }
+        // 朝向取离当前最近的角度，超过 90° 时反向驱动
+        float delta = std::remainder(std::atan2(c[2 * i + 1], c[2 * i]) - currentSteer[i], TWO_PI);
+        if (delta > HALF_PI) {
+            delta -= PI;
+            speed = -speed;
+        } else if (delta < -HALF_PI) {
+            delta += PI;
+            speed = -speed;
+        }
+        modules[i] = {currentSteer[i] + delta, speed};
+    }
+}
+
+BodyTwist SwerveKinematics::forward(const ModuleState* modules) const {
+    float c[2 * MODULES];
+    for (size_t i = 0; i < MODULES; ++i) {
+        const float v = modules[i].speed * radius;
+        c[2 * i] = v * std::cos(modules[i].steer);
+        c[2 * i + 1] = v * std::sin(modules[i].steer);
+    }
+    return components.forward(c);
+}
+
+void SwerveKinematics::inverseBatch(const float* vx, const float* vy, const float* wz, size_t count,
+                                    float* steer, float* speed) const {
+    const float inverseRadius = 1.0f / radius;
+    for (size_t m = 0; m < MODULES; ++m) {
+        const float x = positions[m][0];
+        const float y = positions[m][1];
+        float* steerOut = steer + m * count;
+        float* speedOut = speed + m * count;
+        for (size_t k = 0; k < count; ++k) {
+            const float cx = vx[k] - wz[k] * y;
+            const float cy = vy[k] + wz[k] * x;
+            steerOut[k] = std::atan2(cy, cx);
+            speedOut[k] = std::sqrt(cx * cx + cy * cy) * inverseRadius;
+        }
+    }
+}
+
+GimbalKinematics::GimbalKinematics(float pitchMin, float pitchMax) :
+    pitchMin(pitchMin),
+    pitchMax(pitchMax) {
+}
+
+void GimbalKinematics::inverse(float x, float y, float z, float currentYaw, float& yaw, float& pitch) const {
+    yaw = currentYaw + std::remainder(std::atan2(y, x) - currentYaw, TWO_PI);
+    pitch = std::clamp(std::atan2(z, std::hypot(x, y)), pitchMin, pitchMax);
+}
+
+void GimbalKinematics::forward(float yaw, float pitch, float& x, float& y, float& z) const {
+    const float horizontal = std::cos(pitch);
+    x = horizontal * std::cos(yaw);
+    y = horizontal * std::sin(yaw);
+    z = std::sin(pitch);
+}
+
+void GimbalKinematics::inverseBatch(const float* x, const float* y, const float* z, size_t count,
+                                    float* yaw, float* pitch) const {
+    for (size_t k = 0; k < count; ++k) {
+        yaw[k] = std::atan2(y[k], x[k]);
+        pitch[k] = std::clamp(std::atan2(z[k], std::sqrt(x[k] * x[k] + y[k] * y[k])), pitchMin, pitchMax);
+    }
+}
+
+void GimbalKinematics::forwardBatch(const float* yaw, const float* pitch, size_t count,
+                                    float* x, float* y, float* z) const {
+    for (size_t k = 0; k < count; ++k) {
+        const float horizontal = std::cos(pitch[k]);
+        x[k] = horizontal * std::cos(yaw[k]);
+        y[k] = horizontal * std::sin(yaw[k]);
+        z[k] = std::sin(pitch[k]);
+    }
+}
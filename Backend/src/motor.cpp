@@ -1,12 +1,27 @@
 #include "motor.h"
 #include "motor_com.h"
+#include "motor_group.h"
+#include <chrono>
 #include <iostream>
+#include <limits>
 
 Motor::Motor(int motorId) : 
     motorId(motorId),
     torqueToSend(0.0f),
+    appliedTorque(0.0f),
     currentAngle(0.0f),
-    currentOmega(0.0f) {
+    currentOmega(0.0f),
+    position(0.0),
+    motorCurrent(0.0f),
+    temperature(0.0f),
+    lastFeedbackNs(0),
+    linkState(LinkState::DISCONNECTED),
+    holdZeroTorque(false),
+    disconnectRequested(false),
+    estimatorConfigChanged(false),
+    group(nullptr),
+    groupIndex(0),
+    groupReaders(0) {
     // Create the communication object
     communication = std::make_unique<MotorCommunication>(this);
 }
@@ -15,11 +30,41 @@ Motor::~Motor() {
     disconnect();
 }
 
-bool Motor::connect(const std::string& ipAddress, int port) {
-    return communication->connect(ipAddress, port);
+bool Motor::connect(const std::string& ipAddress, int port, const TransportOptions& options) {
+    disconnectRequested.store(false);
+    return communication->connect(ipAddress, port, options);
+}
+
+bool Motor::connect(std::unique_ptr<Transport> transport) {
+    disconnectRequested.store(false);
+    return communication->connect(std::move(transport));
+}
+
+bool Motor::connectUri(const std::string& uri) {
+    disconnectRequested.store(false);
+    ProtocolOptions options = communication->protocol();
+    if (parseProtocolOptions(uri, options)) {
+        communication->setProtocol(options);
+    }
+    return communication->connect(createTransport(uri));
+}
+
+void Motor::setProtocol(const ProtocolOptions& options) {
+    communication->setProtocol(options);
+}
+
+ProtocolOptions Motor::getProtocol() const {
+    return communication->protocol();
+}
+
+bool Motor::reconnect() {
+    disconnectRequested.store(false);
+    return communication->reconnect();
 }
 
 void Motor::disconnect() {
+    // 先记下意图再断开：监管线程随后完成的重连会被撤销
+    disconnectRequested.store(true);
     if (communication) {
         communication->disconnect();
     }
@@ -34,17 +79,116 @@ void Motor::setTorque(float torqueNm) {
 }
 
 float Motor::getTorque() const {
-    return torqueToSend.load();
+    // 先登记再读组指针：MotorGroup::release 解除指针后等待计数归零，读取期间组不会被销毁
+    groupReaders.fetch_add(1);
+    const MotorGroup* owner = group.load();
+    const float torque = owner ? owner->commandTorque(groupIndex) : torqueToSend.load();
+    groupReaders.fetch_sub(1);
+    return torque;
+}
+
+MotorGroup* Motor::getGroup() const {
+    return group.load(std::memory_order_acquire);
 }
 
 float Motor::getCurrentAngle() const {
     return currentAngle.load();
 }
 
+double Motor::getPosition() const {
+    return position.load();
+}
+
+int64_t Motor::getTurns() const {
+    return state.load().turns;
+}
+
 float Motor::getCurrentOmega() const {
     return currentOmega.load();
 }
 
+float Motor::getMotorCurrent() const {
+    return motorCurrent.load();
+}
+
+float Motor::getTemperature() const {
+    return temperature.load();
+}
+
+MotorState Motor::getState() const {
+    return state.load();
+}
+
+ClockSync::Estimate Motor::getClockSync() const {
+    return clockEstimate.load();
+}
+
+EstimatedState Motor::getEstimate() const {
+    return estimate.load();
+}
+
+EstimatedState Motor::predict(int64_t timeNs, float maxHorizon) const {
+    return StateEstimator::extrapolate(estimate.load(), timeNs, maxHorizon);
+}
+
+void Motor::setEstimatorConfig(const EstimatorConfig& config) {
+    estimatorConfig.store(config);
+    estimatorConfigChanged.store(true, std::memory_order_release);
+}
+
+EstimatorConfig Motor::getEstimatorConfig() const {
+    return estimatorConfig.load();
+}
+
 int Motor::getMotorId() const {
     return motorId;
+}
+
+TransportStats Motor::getLinkStats() const {
+    return communication ? communication->stats() : TransportStats{};
+}
+
+LinkState Motor::getLinkState() const {
+    return linkState.load();
+}
+
+double Motor::getFeedbackAge() const {
+    const int64_t last = lastFeedbackNs.load(std::memory_order_acquire);
+    if (last == 0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return static_cast<double>(steadyNowNs() - last) * 1e-9;
+}
+
+void Motor::setHoldZeroTorque(bool hold) {
+    holdZeroTorque.store(hold);
+}
+
+bool Motor::isHoldingZeroTorque() const {
+    return holdZeroTorque.load();
+}
+
+float Motor::getCommandTorque() const {
+    return holdZeroTorque.load(std::memory_order_relaxed) ? 0.0f : getTorque();
+}
+
+float Motor::getAppliedTorque() const {
+    return appliedTorque.load(std::memory_order_relaxed);
+}
+
+void Motor::setSafetyLimits(const SafetyLimits& limits) {
+    safety.setLimits(limits);
+}
+
+SafetyLimits Motor::getSafetyLimits() const {
+    return safety.limits();
+}
+
+SafetyStats Motor::getSafetyStats() const {
+    return safety.stats();
+}
+
+int64_t Motor::steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
 }
\ No newline at end of file
@@ -1,83 +1,108 @@
 #include "motor_com.h"
 #include "motor.h"
+#include "tcp_transport.h"
+#include "profiler.h"
+#include <algorithm>
 #include <iostream>
-#include <cstring>
 #include <chrono>
-#include <vector>
 
-#pragma comment(lib, "ws2_32.lib")
-
-// 通信协议常量
-const uint8_t FEEDBACK_HEADER = 0xA0;
-const uint8_t COMMAND_HEADER = 0xA1;
-const size_t FEEDBACK_PACKET_SIZE = 11; // A0 + ID + Angle(4) + Speed(4) + Checksum
-const size_t COMMAND_PACKET_SIZE = 7;   // A1 + ID + Torque(4) + Checksum
+// 接收等待超时，保证断开连接时接收线程能及时退出
+constexpr int RECEIVE_TIMEOUT_MS = 100;
 
 MotorCommunication::MotorCommunication(Motor* motor) :
-    sock(INVALID_SOCKET),
     connected(false),
     shouldExit(false),
     motor(motor),
-    receiveBuffer(256),
-    bufferPosition(0) {
-    initializeWinsock();
+    framer(256),
+    feedbackCount(0),
+    reportedChecksumErrors(0),
+    checksumErrors(0) {
 }
 
 MotorCommunication::~MotorCommunication() {
     disconnect();
 }
 
-bool MotorCommunication::initializeWinsock() {
-    static bool initialized = false;
-
-    if (!initialized) {
-        WSADATA wsaData;
-        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
-            std::cerr << "WSAStartup failed." << std::endl;
-            return false;
-        }
-        initialized = true;
+bool MotorCommunication::connect(const std::string& ipAddress, int port, const TransportOptions& options) {
+    if (isConnected()) {
+        return true;
     }
-
-    return true;
+    return connect(std::make_unique<TcpTransport>(ipAddress, port, options));
 }
 
-bool MotorCommunication::connect(const std::string& ipAddress, int port) {
-    if (connected) {
+bool MotorCommunication::connect(std::unique_ptr<Transport> newTransport) {
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+    if (connected && !shouldExit) {
         return true;
     }
+    if (!newTransport) {
+        return false;
+    }
 
-    sock = socket(AF_INET, SOCK_STREAM, 0);
-    if (sock == INVALID_SOCKET) {
-        std::cerr << "Socket creation failed." << std::endl;
+    // 线程已因链路错误退出时 connected 仍为 true，需先回收
+    stopLocked();
+    transport = std::move(newTransport);
+    return startLocked();
+}
+
+bool MotorCommunication::reconnect() {
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+    if (!transport) {
         return false;
     }
+    stopLocked();
+    return startLocked();
+}
 
-    sockaddr_in serverAddr{};
-    serverAddr.sin_family = AF_INET;
-    serverAddr.sin_port = htons(port);
-    serverAddr.sin_addr.s_addr = inet_addr(ipAddress.c_str());
+void MotorCommunication::disconnect() {
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+    if (!connected) {
+        return;
+    }
+    stopLocked();
+    motor->linkState.store(LinkState::DISCONNECTED);
+    std::cout << "Disconnected motor ID " << static_cast<int>(motor->getMotorId()) << " from server." << std::endl;
+}
 
-    if (::connect(sock, reinterpret_cast<sockaddr *>(&serverAddr), sizeof(serverAddr)) < 0) {
-        std::cerr << "Connection failed." << std::endl;
-        closesocket(sock);
-        sock = INVALID_SOCKET;
+bool MotorCommunication::isConnected() const {
+    return connected && !shouldExit;
+}
+
+void MotorCommunication::setProtocol(const ProtocolOptions& options) {
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+    protocolOptions = options;
+}
+
+ProtocolOptions MotorCommunication::protocol() const {
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+    return protocolOptions;
+}
+
+bool MotorCommunication::startLocked() {
+    if (!transport->open()) {
         return false;
     }
 
-    std::cout << "Connected to Unity server at " << ipAddress << ":" << port
+    framer.setVersion(protocolOptions.version);
+    // 设备可能已重启，时钟需要重新同步
+    clockSync.reset();
+    estimator.reset();
+    // angleTracker 不重置：重连后多圈位置从断开前的圈数继续
+
+    std::cout << "Connected to " << transport->describe()
               << " for motor ID " << static_cast<int>(motor->getMotorId()) << std::endl;
-    connected = true;
     shouldExit = false;
+    connected = true;
+    motor->linkState.store(LinkState::CONNECTING);
 
     // Start threads
-    senderThread = std::thread(&MotorCommunication::sendThreadFunc, this);
+    senderThread = std::thread(&MotorCommunication::sendThreadFunc, this, protocolOptions);
     receiverThread = std::thread(&MotorCommunication::receiveThreadFunc, this);
 
     return true;
 }
 
-void MotorCommunication::disconnect() {
+void MotorCommunication::stopLocked() {
     if (!connected) {
         return;
     }
@@ -92,52 +117,45 @@ void MotorCommunication::disconnect() {
         receiverThread.join();
     }
 
-    closesocket(sock);
-    sock = INVALID_SOCKET;
+    transport->close();
     connected = false;
-    std::cout << "Disconnected motor ID " << static_cast<int>(motor->getMotorId()) << " from server." << std::endl;
+    motor->appliedTorque.store(0.0f, std::memory_order_relaxed);
 }
 
-bool MotorCommunication::isConnected() const {
-    return connected;
-}
+void MotorCommunication::sendThreadFunc(ProtocolOptions options) {
+    profiler::setThreadName("send/" + std::to_string(motor->getMotorId()));
+    uint8_t packet[MAX_COMMAND_SIZE];
+    CommandMessage command;
+    command.motorId = static_cast<uint8_t>(motor->getMotorId());
+    command.fields = protocol::CommandTorque::mask |
+                     (options.commandTimestamp ? protocol::CommandHostTime::mask : 0);
 
-void MotorCommunication::sendThreadFunc() {
     while (!shouldExit) {
-        // 准备控制指令包 (上位机发送扭矩指令)
-        std::vector<uint8_t> packet(COMMAND_PACKET_SIZE);
-
-        // 包头
-        packet[0] = COMMAND_HEADER;
-        // 电机ID
-        packet[1] = motor->getMotorId();
-
-        // 扭矩数据
-        float torque = motor->getTorque();
-        std::memcpy(&packet[2], &torque, 4);
-
-        // 计算校验和
-        uint8_t checksum = 0;
-        for (size_t i = 0; i < COMMAND_PACKET_SIZE - 1; ++i) {
-            checksum ^= packet[i];
-        }
-        packet[COMMAND_PACKET_SIZE - 1] = checksum;
-
-        // 发送控制指令
-        int sent = send(sock, reinterpret_cast<const char*>(packet.data()), packet.size(), 0);
-        if (sent != COMMAND_PACKET_SIZE) {
-            std::lock_guard<std::mutex> lock(consoleMutex);
-            std::cerr << "Motor ID " << static_cast<int>(motor->getMotorId())
-                      << " - Failed to send command packet." << std::endl;
-            shouldExit = true;
-            break;
-        }
-
-        // 调试输出
         {
-            std::lock_guard<std::mutex> lock(consoleMutex);
-            std::cout << "Motor ID " << static_cast<int>(motor->getMotorId())
-                      << " - Sent torque command: " << torque << " Nm" << std::endl;
+            // 计时不含周期休眠
+            PROFILE_ZONE("send");
+
+            // 准备控制指令包 (上位机发送扭矩指令)
+            const int64_t now = Motor::steadyNowNs();
+            const int64_t lastFeedback = motor->lastFeedbackNs.load(std::memory_order_acquire);
+            const float torque = motor->safety.apply(motor->getCommandTorque(),
+                                                     motor->position.load(std::memory_order_relaxed),
+                                                     lastFeedback > 0 ? now - lastFeedback : -1, now);
+            command.torque = torque;
+            command.hostTimeNs = static_cast<uint64_t>(now);
+            const size_t size = encodeCommand(command, options, packet);
+
+            // 发送控制指令
+            if (!transport->send(packet, size)) {
+                std::lock_guard<std::mutex> lock(consoleMutex);
+                std::cerr << "Motor ID " << static_cast<int>(motor->getMotorId())
+                          << " - Failed to send command packet." << std::endl;
+                motor->linkState.store(LinkState::DISCONNECTED);
+                motor->appliedTorque.store(0.0f, std::memory_order_relaxed);
+                shouldExit = true;
+                break;
+            }
+            motor->appliedTorque.store(torque, std::memory_order_relaxed);
         }
 
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
@@ -145,100 +163,117 @@ void MotorCommunication::sendThreadFunc() {
 }
 
 void MotorCommunication::receiveThreadFunc() {
+    profiler::setThreadName("recv/" + std::to_string(motor->getMotorId()));
     while (!shouldExit) {
-        // 接收反馈数据
-        int received = recv(sock, reinterpret_cast<char*>(receiveBuffer.data() + bufferPosition),
-                     receiveBuffer.size() - bufferPosition, 0);
-        if (received <= 0) {
+        // 接收反馈数据，直接写入组帧缓冲区。writePtr 可能挪动缓冲区，须先于 writable 求值
+        uint8_t* target = framer.writePtr();
+        int received = transport->receive(target, framer.writable(), RECEIVE_TIMEOUT_MS);
+        if (received < 0) {
             std::lock_guard<std::mutex> lock(consoleMutex);
             std::cerr << "Motor ID " << static_cast<int>(motor->getMotorId())
                       << " - Receive failed or disconnected." << std::endl;
+            motor->linkState.store(LinkState::DISCONNECTED);
             shouldExit = true;
             return;
         }
+        if (received == 0) {
+            continue;
+        }
 
-        bufferPosition += received;
+        // 计时不含阻塞等待数据的时间，从数据到达开始：组帧、解析与状态发布
+        PROFILE_ZONE("receive");
+        framer.commit(static_cast<size_t>(received));
         processReceivedData();
     }
 }
 
 void MotorCommunication::processReceivedData() {
-    while (bufferPosition >= FEEDBACK_PACKET_SIZE) {
-        // 查找反馈包头
-        size_t packetStart = 0;
-        bool found = false;
-
-        for (size_t i = 0; i <= bufferPosition - FEEDBACK_PACKET_SIZE; ++i) {
-            if (receiveBuffer[i] == FEEDBACK_HEADER) {
-                packetStart = i;
-                found = true;
-                break;
-            }
+    PROFILE_ZONE("parse");
+    constexpr uint8_t KINEMATIC_FIELDS = protocol::FeedbackAngle::mask | protocol::FeedbackOmega::mask;
+    const int64_t received = Motor::steadyNowNs();
+    while (true) {
+        // 每帧重新清零：v2 帧只写入掩码中置位的字段，不能沿用上一帧的值
+        FeedbackFramer::Feedback feedback{};
+        if (!framer.next(feedback)) {
+            break;
         }
-
-        if (!found) {
-            // 没有找到完整包，清理缓冲区
-            if (bufferPosition > FEEDBACK_PACKET_SIZE) {
-                std::memmove(receiveBuffer.data(), receiveBuffer.data() + bufferPosition - FEEDBACK_PACKET_SIZE + 1,
-                            FEEDBACK_PACKET_SIZE - 1);
-                bufferPosition = FEEDBACK_PACKET_SIZE - 1;
-            }
-            return;
+        if (feedback.motorId != motor->getMotorId()) {
+            continue;
         }
-
-        // 检查是否有足够数据
-        if (bufferPosition - packetStart < FEEDBACK_PACKET_SIZE) {
-            // 数据不足，等待更多数据
-            if (packetStart > 0) {
-                std::memmove(receiveBuffer.data(), receiveBuffer.data() + packetStart, bufferPosition - packetStart);
-                bufferPosition -= packetStart;
+        // 角度与速度齐全才是一个运动学采样，只有它更新位置 / 速度、估计器、序号与反馈看门狗；
+        // 缺任一字段的帧（如只带电流 / 温度的 v2 帧）只更新其携带的字段
+        const bool kinematic = (feedback.fields & KINEMATIC_FIELDS) == KINEMATIC_FIELDS;
+
+        // 设备时间戳经时钟同步换算为上位机时间作为采样时刻，不会晚于到达时刻
+        int64_t sampleTime = received;
+        const bool echoed = (feedback.fields & protocol::FeedbackCommandTime::mask) && feedback.commandTimeNs > 0;
+        if (feedback.fields & protocol::FeedbackDeviceTime::mask) {
+            if (clockSync.addSample(echoed ? static_cast<int64_t>(feedback.commandTimeNs) : -1,
+                                    feedback.deviceTimeUs, received)) {
+                motor->clockEstimate.store(clockSync.estimate());
+            }
+            const int64_t converted = clockSync.toHost(feedback.deviceTimeUs);
+            if (converted > 0) {
+                sampleTime = std::min(converted, received);
             }
-            return;
         }
 
-        // 校验和检查
-        uint8_t checksum = 0;
-        for (size_t i = 0; i < FEEDBACK_PACKET_SIZE - 1; ++i) {
-            checksum ^= receiveBuffer[packetStart + i];
+        // 更新电机状态
+        MotorState state = motor->state.load();
+        if (feedback.fields & protocol::FeedbackCurrent::mask) {
+            state.current = feedback.current;
+            motor->motorCurrent.store(feedback.current, std::memory_order_relaxed);
         }
-
-        if (checksum != receiveBuffer[packetStart + FEEDBACK_PACKET_SIZE - 1]) {
-            std::lock_guard<std::mutex> lock(consoleMutex);
-            std::cerr << "Motor ID " << static_cast<int>(motor->getMotorId())
-                      << " - Checksum error in feedback packet." << std::endl;
-
-            bufferPosition--;
-            std::memmove(receiveBuffer.data() + packetStart, receiveBuffer.data() + packetStart + 1,
-                        bufferPosition - packetStart);
+        if (feedback.fields & protocol::FeedbackTemperature::mask) {
+            state.temperature = feedback.temperature;
+            motor->temperature.store(feedback.temperature, std::memory_order_relaxed);
+        }
+        if (kinematic) {
+            state.angle = feedback.angle;
+            state.position = angleTracker.update(feedback.angle);
+            state.turns = angleTracker.turns();
+            state.omega = feedback.omega;
+            state.sampleTimeNs = sampleTime;
+            state.receiveTimeNs = received;
+            state.commandTimeNs = echoed ? static_cast<int64_t>(feedback.commandTimeNs) : 0;
+            state.sequence = ++feedbackCount;
+        }
+        motor->state.store(state);
+        if (!kinematic) {
             continue;
         }
 
-        // 提取电机ID和反馈数据
-        uint8_t receivedId = receiveBuffer[packetStart + 1];
-        if (receivedId == motor->getMotorId()) {
-            float angleDeg, omega;
-            std::memcpy(&angleDeg, &receiveBuffer[packetStart + 2], 4);
-            std::memcpy(&omega, &receiveBuffer[packetStart + 6], 4);
-
-            // 更新电机状态
-            motor->currentAngle = angleDeg;
-            motor->currentOmega = omega;
-
-            // // 调试输出
-            // {
-            //     std::lock_guard<std::mutex> lock(consoleMutex);
-            //     std::cout << "Motor ID " << static_cast<int>(motor->getMotorId())
-            //               << " - Received feedback: Angle=" << angleDeg
-            //               << "°, Omega=" << omega << "rad/s" << std::endl;
-            // }
+        // 配置更新只在接收线程中应用，估计器本身不需要加锁
+        if (motor->estimatorConfigChanged.exchange(false, std::memory_order_acquire)) {
+            estimator.setConfig(motor->estimatorConfig.load());
         }
+        estimator.update(state.position, feedback.omega, sampleTime);
+        motor->estimate.store(estimator.state());
+
+        motor->currentAngle = feedback.angle;
+        motor->position.store(state.position);
+        motor->currentOmega = feedback.omega;
+        motor->lastFeedbackNs.store(received, std::memory_order_release);
+        // 连接后的第一帧反馈标志链路可用
+        LinkState expected = LinkState::CONNECTING;
+        motor->linkState.compare_exchange_strong(expected, LinkState::UP);
+    }
 
-        // 移除已处理的数据包
-        size_t remainingBytes = bufferPosition - (packetStart + FEEDBACK_PACKET_SIZE);
-        if (remainingBytes > 0) {
-            std::memmove(receiveBuffer.data(), receiveBuffer.data() + packetStart + FEEDBACK_PACKET_SIZE,
-                        remainingBytes);
-        }
-        bufferPosition = remainingBytes;
+    const uint64_t errors = framer.checksumErrors();
+    if (errors != reportedChecksumErrors) {
+        std::lock_guard<std::mutex> lock(consoleMutex);
+        std::cerr << "Motor ID " << static_cast<int>(motor->getMotorId())
+                  << " - Checksum error in feedback packet ("
+                  << errors - reportedChecksumErrors << ")." << std::endl;
+        reportedChecksumErrors = errors;
+        checksumErrors.store(errors, std::memory_order_relaxed);
     }
-}
\ No newline at end of file
+}
+
+TransportStats MotorCommunication::stats() const {
+    // connect 可能在其他线程中替换并销毁 transport，读取时须持有生命周期锁
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+    TransportStats result = transport ? transport->stats() : TransportStats{};
+    result.checksumErrors = checksumErrors.load(std::memory_order_relaxed);
+    return result;
+}
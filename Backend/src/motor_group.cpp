@@ -0,0 +1,104 @@
+#include "motor_group.h"
+#include "motor.h"
+#include <algorithm>
+#include <thread>
+
+MotorGroup::MotorGroup(std::string name) :
+    groupName(std::move(name)),
+    published(0) {
+}
+
+MotorGroup::~MotorGroup() {
+    for (Motor* motor : members) {
+        if (motor) {
+            release(motor);
+        }
+    }
+}
+
+void MotorGroup::release(Motor* motor) {
+    // 先清零再解除：发送线程一旦不再经由组取力矩，读到的就是 0 而不是加入组之前留下的旧值
+    motor->torqueToSend.store(0.0f);
+    motor->group.store(nullptr);
+    // 与 Motor::getTorque 的读者计数配合（均为顺序一致）：计数归零后不会再有线程持有本组指针
+    while (motor->groupReaders.load() != 0) {
+        std::this_thread::yield();
+    }
+}
+
+bool MotorGroup::add(Motor* motor) {
+    if (!motor || members.size() >= MAX_MEMBERS || motor->group.load() != nullptr) {
+        return false;
+    }
+    motor->groupIndex = members.size();
+    members.push_back(motor);
+    // 先写入序号再发布组指针，发送线程看到指针时序号已就绪
+    motor->group.store(this, std::memory_order_release);
+    return true;
+}
+
+void MotorGroup::detach(Motor* motor) {
+    auto it = std::find(members.begin(), members.end(), motor);
+    if (it == members.end()) {
+        return;
+    }
+    release(motor);
+    *it = nullptr;
+}
+
+const std::string& MotorGroup::name() const {
+    return groupName;
+}
+
+size_t MotorGroup::size() const {
+    return members.size();
+}
+
+Motor* MotorGroup::member(size_t index) const {
+    return index < members.size() ? members[index] : nullptr;
+}
+
+bool MotorGroup::contains(const Motor* motor) const {
+    return std::find(members.begin(), members.end(), motor) != members.end();
+}
+
+void MotorGroup::publish(const float* torques) {
+    Command command;
+    command.generation = ++published;
+    std::copy(torques, torques + members.size(), command.torque);
+    current.store(command);
+}
+
+void MotorGroup::zero() {
+    Command command;
+    command.generation = ++published;
+    current.store(command);
+}
+
+MotorGroup::Command MotorGroup::command() const {
+    return current.load();
+}
+
+uint64_t MotorGroup::generation() const {
+    return current.load().generation;
+}
+
+float MotorGroup::commandTorque(size_t index) const {
+    return index < MAX_MEMBERS ? current.load().torque[index] : 0.0f;
+}
+
+void MotorGroup::readJoints(Joints& joints) const {
+    joints.count = members.size();
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (!members[i]) {
+            joints.position[i] = 0.0;
+            joints.omega[i] = 0.0f;
+            joints.sampleTimeNs[i] = 0;
+            continue;
+        }
+        const MotorState state = members[i]->getState();
+        joints.position[i] = state.position;
+        joints.omega[i] = state.omega;
+        joints.sampleTimeNs[i] = state.sampleTimeNs;
+    }
+}
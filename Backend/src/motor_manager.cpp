@@ -1,5 +1,7 @@
 #include "motor_manager.h"
+#include <future>
 #include <iostream>
+#include <vector>
 
 MotorManager& MotorManager::getInstance() {
     static MotorManager instance;
@@ -17,22 +19,72 @@ Motor* MotorManager::getMotor(int motorId) {
 }
 
 void MotorManager::removeMotor(int motorId) {
+    supervisor.unwatch(motorId);
+    if (Motor* motor = getMotor(motorId)) {
+        if (MotorGroup* group = motor->getGroup()) {
+            group->detach(motor);
+        }
+    }
     motors.erase(motorId);
 }
 
-bool MotorManager::connectMotor(int motorId, const std::string& ipAddress, int port) {
+MotorGroup* MotorManager::createGroup(const std::string& name, const std::vector<int>& motorIds) {
+    if (groups.count(name) != 0) {
+        std::cerr << "Motor group " << name << " already exists." << std::endl;
+        return nullptr;
+    }
+    auto group = std::make_unique<MotorGroup>(name);
+    for (int motorId : motorIds) {
+        if (!group->add(getMotor(motorId))) {
+            std::cerr << "Cannot add motor " << motorId << " to group " << name << "." << std::endl;
+            return nullptr;
+        }
+    }
+    return groups.emplace(name, std::move(group)).first->second.get();
+}
+
+MotorGroup* MotorManager::getGroup(const std::string& name) {
+    auto it = groups.find(name);
+    return it != groups.end() ? it->second.get() : nullptr;
+}
+
+void MotorManager::removeGroup(const std::string& name) {
+    groups.erase(name);
+}
+
+bool MotorManager::connectMotor(int motorId, const std::string& ipAddress, int port, const TransportOptions& options) {
     Motor* motor = getMotor(motorId);
     if (!motor) {
         std::cerr << "Motor " << motorId << " not found." << std::endl;
         return false;
     }
-    return motor->connect(ipAddress, port);
+    return motor->connect(ipAddress, port, options);
 }
 
-bool MotorManager::connectAll(const std::string& ipAddress, int basePort) {
-    bool allConnected = true;
+bool MotorManager::connectMotorUri(int motorId, const std::string& uri) {
+    Motor* motor = getMotor(motorId);
+    if (!motor) {
+        std::cerr << "Motor " << motorId << " not found." << std::endl;
+        return false;
+    }
+    return motor->connectUri(uri);
+}
+
+bool MotorManager::connectAll(const std::string& ipAddress, int basePort, const TransportOptions& options) {
+    // 每个连接各自阻塞，并行发起使总耗时取决于最慢的一个
+    std::vector<std::pair<int, std::future<bool>>> pending;
+    pending.reserve(motors.size());
     for (const auto& [motorId, motor] : motors) {
-        if (!connectMotor(motorId, ipAddress, basePort + motorId)) {
+        Motor* target = motor.get();
+        const int port = basePort + motorId;
+        pending.emplace_back(motorId, std::async(std::launch::async, [target, ipAddress, port, options]() {
+            return target->connect(ipAddress, port, options);
+        }));
+    }
+
+    bool allConnected = true;
+    for (auto& [motorId, result] : pending) {
+        if (!result.get()) {
             std::cerr << "Failed to connect motor " << motorId
                       << " on port " << (basePort + motorId) << std::endl;
             allConnected = false;
@@ -50,6 +102,36 @@ void MotorManager::disconnectAll() {
     }
 }
 
+void MotorManager::emergencyStop() {
+    SafetyGuard::emergencyStop();
+    for (const auto& [motorId, motor] : motors) {
+        motor->setTorque(0.0f);
+    }
+    // 电机组的指令只由其控制线程发布（单写者顺序锁），这里不写入；
+    // 安全层的急停锁存在一个发送周期内已将组成员的下发力矩清零
+    std::cerr << "Emergency stop engaged." << std::endl;
+}
+
+void MotorManager::clearEmergencyStop() {
+    SafetyGuard::clearEmergencyStop();
+}
+
+void MotorManager::startSupervisor(const ConnectionSupervisor::Config& config) {
+    for (const auto& [motorId, motor] : motors) {
+        supervisor.watch(motor.get());
+    }
+    supervisor.start(config);
+}
+
+void MotorManager::stopSupervisor() {
+    supervisor.stop();
+}
+
+ConnectionSupervisor& MotorManager::getSupervisor() {
+    return supervisor;
+}
+
 MotorManager::~MotorManager() {
+    supervisor.stop();
     disconnectAll();
 }
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "packet_framer.h"
+#include <algorithm>
+#include <cstring>
+
+uint8_t xorChecksum(const uint8_t* data, size_t size) {
+    uint8_t checksum = 0;
+    for (size_t i = 0; i < size; ++i) {
+        checksum ^= data[i];
+    }
+    return checksum;
+}
+
+void encodeCommand(uint8_t motorId, float torque, uint8_t* out) {
+    // 包头
+    out[0] = COMMAND_HEADER;
+    // 电机ID
+    out[1] = motorId;
+    // 扭矩数据
+    std::memcpy(&out[2], &torque, 4);
+    // 计算校验和
+    out[COMMAND_PACKET_SIZE - 1] = xorChecksum(out, COMMAND_PACKET_SIZE - 1);
+}
+
+size_t encodeCommand(const CommandMessage& command, const ProtocolOptions& options, uint8_t* out) {
+    if (options.version == ProtocolVersion::V1) {
+        encodeCommand(command.motorId, command.torque, out);
+        return COMMAND_PACKET_SIZE;
+    }
+    return protocol::encode<protocol::CommandLayout>(command, options.crc, out);
+}
+
+size_t encodeFeedback(const FeedbackMessage& feedback, const ProtocolOptions& options, uint8_t* out) {
+    if (options.version == ProtocolVersion::V1) {
+        out[0] = FEEDBACK_HEADER;
+        out[1] = feedback.motorId;
+        std::memcpy(&out[2], &feedback.angle, 4);
+        std::memcpy(&out[6], &feedback.omega, 4);
+        out[FEEDBACK_PACKET_SIZE - 1] = xorChecksum(out, FEEDBACK_PACKET_SIZE - 1);
+        return FEEDBACK_PACKET_SIZE;
+    }
+    return protocol::encode<protocol::FeedbackLayout>(feedback, options.crc, out);
+}
+
+FeedbackFramer::FeedbackFramer(size_t capacity, ProtocolVersion version) :
+    buffer(std::max(capacity, MAX_FEEDBACK_SIZE * 2)),
+    readPosition(0),
+    writePosition(0),
+    checksumErrorCount(0),
+    protocolVersion(ProtocolVersion::V1),
+    minFrame(FEEDBACK_PACKET_SIZE) {
+    setVersion(version);
+}
+
+void FeedbackFramer::setVersion(ProtocolVersion version) {
+    protocolVersion = version;
+    minFrame = version == ProtocolVersion::V1 ? FEEDBACK_PACKET_SIZE
+                                              : protocol::V2_PREFIX_SIZE + protocol::crcSize(CrcKind::CRC16);
+    clear();
+}
+
+ProtocolVersion FeedbackFramer::version() const {
+    return protocolVersion;
+}
+
+uint8_t* FeedbackFramer::writePtr() {
+    // 尾部空间不足一个最长包时把未处理数据挪到缓冲区头部
+    if (buffer.size() - writePosition < MAX_FEEDBACK_SIZE) {
+        compact();
+    }
+    return buffer.data() + writePosition;
+}
+
+size_t FeedbackFramer::writable() const {
+    return buffer.size() - writePosition;
+}
+
+void FeedbackFramer::commit(size_t size) {
+    writePosition = std::min(writePosition + size, buffer.size());
+}
+
+size_t FeedbackFramer::push(const uint8_t* data, size_t size) {
+    size_t total = 0;
+    while (total < size) {
+        uint8_t* dst = writePtr();
+        const size_t chunk = std::min(size - total, writable());
+        if (chunk == 0) {
+            break;
+        }
+        std::memcpy(dst, data + total, chunk);
+        commit(chunk);
+        total += chunk;
+    }
+    return total;
+}
+
+bool FeedbackFramer::next(Feedback& feedback) {
+    return protocolVersion == ProtocolVersion::V1 ? nextV1(feedback) : nextV2(feedback);
+}
+
+bool FeedbackFramer::nextV1(Feedback& feedback) {
+    while (writePosition - readPosition >= FEEDBACK_PACKET_SIZE) {
+        // 查找反馈包头
+        const uint8_t* begin = buffer.data() + readPosition;
+        const uint8_t* end = buffer.data() + writePosition - FEEDBACK_PACKET_SIZE + 1;
+        const uint8_t* header = static_cast<const uint8_t*>(
+            std::memchr(begin, FEEDBACK_HEADER, static_cast<size_t>(end - begin)));
+
+        if (!header) {
+            // 没有找到包头，只保留可能属于下一个包的尾部字节
+            readPosition = writePosition - (FEEDBACK_PACKET_SIZE - 1);
+            compact();
+            return false;
+        }
+
+        const size_t packetStart = static_cast<size_t>(header - buffer.data());
+
+        // 校验和检查，失败则从包头后一个字节继续搜索
+        if (xorChecksum(header, FEEDBACK_PACKET_SIZE - 1) != header[FEEDBACK_PACKET_SIZE - 1]) {
+            ++checksumErrorCount;
+            readPosition = packetStart + 1;
+            continue;
+        }
+
+        // 提取电机ID和反馈数据
+        feedback.motorId = header[1];
+        feedback.fields = protocol::FeedbackAngle::mask | protocol::FeedbackOmega::mask;
+        std::memcpy(&feedback.angle, header + 2, 4);
+        std::memcpy(&feedback.omega, header + 6, 4);
+
+        readPosition = packetStart + FEEDBACK_PACKET_SIZE;
+        if (readPosition == writePosition) {
+            readPosition = writePosition = 0;
+        }
+        return true;
+    }
+
+    // 数据不足，等待更多数据
+    return false;
+}
+
+bool FeedbackFramer::nextV2(Feedback& feedback) {
+    while (writePosition - readPosition >= minFrame) {
+        // 查找 v2 帧头
+        const uint8_t* begin = buffer.data() + readPosition;
+        const uint8_t* header = static_cast<const uint8_t*>(
+            std::memchr(begin, protocol::V2_HEADER, writePosition - readPosition));
+
+        if (!header) {
+            readPosition = writePosition = 0;
+            return false;
+        }
+
+        const size_t packetStart = static_cast<size_t>(header - buffer.data());
+        const int result = protocol::decode<protocol::FeedbackLayout>(header, writePosition - packetStart, feedback);
+        if (result == 0) {
+            // 帧不完整，等待更多数据
+            readPosition = packetStart;
+            return false;
+        }
+        if (result < 0) {
+            // 版本 / 掩码 / CRC 不符，从帧头后一个字节继续搜索
+            ++checksumErrorCount;
+            readPosition = packetStart + 1;
+            continue;
+        }
+
+        readPosition = packetStart + static_cast<size_t>(result);
+        if (readPosition == writePosition) {
+            readPosition = writePosition = 0;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+void FeedbackFramer::clear() {
+    readPosition = 0;
+    writePosition = 0;
+}
+
+size_t FeedbackFramer::buffered() const {
+    return writePosition - readPosition;
+}
+
+uint64_t FeedbackFramer::checksumErrors() const {
+    return checksumErrorCount;
+}
+
+void FeedbackFramer::compact() {
+    if (readPosition == 0) {
+        return;
+    }
+    const size_t remaining = writePosition - readPosition;
+    if (remaining > 0) {
+        std::memmove(buffer.data(), buffer.data() + readPosition, remaining);
+    }
+    readPosition = 0;
+    writePosition = remaining;
+}
@@ -0,0 +1,691 @@
+#include "profiler.h"
+#include "socket_compat.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#ifdef __linux__
+#include <filesystem>
+#include <pthread.h>
+#include <sys/syscall.h>
+#endif
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace profiler {
+
+namespace {
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t currentThreadId() {
+#if defined(__linux__)
+    return static_cast<int64_t>(::syscall(SYS_gettid));
+#elif defined(_WIN32)
+    return static_cast<int64_t>(::GetCurrentThreadId());
+#else
+    return static_cast<int64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+#endif
+}
+
+struct Event {
+    const Site* site;
+    int64_t startNs;
+    int64_t durationNs;
+};
+
+// 每个线程的追踪缓冲区。只有所属线程写入，导出时由其他线程读取，二者用 mutex 互斥（写入时无竞争）
+struct ThreadState {
+    int64_t id = 0;
+    std::mutex mutex;
+    std::string name;
+    std::vector<Event> events;
+    size_t next = 0;
+    bool wrapped = false;
+    std::atomic<bool> alive{true};
+#ifdef _WIN32
+    HANDLE handle = nullptr;
+#endif
+
+    [[nodiscard]] bool hasEvents() const { return next > 0 || wrapped; }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<const Site*> sites;
+    std::vector<std::shared_ptr<ThreadState>> threads;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+std::atomic<bool> tracing{false};
+std::atomic<size_t> traceCapacity{16384};
+
+// 线程退出时标记结束；没有追踪事件的线程直接移出列表，重连产生的新线程不会让列表无限增长
+struct ThreadHandle {
+    std::shared_ptr<ThreadState> state;
+
+    ~ThreadHandle() {
+        if (!state) {
+            return;
+        }
+        state->alive = false;
+#ifdef _WIN32
+        if (state->handle) {
+            ::CloseHandle(state->handle);
+            state->handle = nullptr;
+        }
+#endif
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        std::lock_guard<std::mutex> stateLock(state->mutex);
+        if (!state->hasEvents()) {
+            r.threads.erase(std::remove(r.threads.begin(), r.threads.end(), state), r.threads.end());
+        }
+    }
+};
+
+thread_local ThreadHandle current;
+
+ThreadState& currentThread() {
+    if (!current.state) {
+        auto state = std::make_shared<ThreadState>();
+        state->id = currentThreadId();
+#ifdef _WIN32
+        state->handle = ::OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, ::GetCurrentThreadId());
+#endif
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.threads.push_back(state);
+        current.state = std::move(state);
+    }
+    return *current.state;
+}
+
+// 在锁外分配追踪缓冲区，再在锁内换入，所属线程等待的只是一次交换
+void reserveEvents(ThreadState& thread) {
+    {
+        std::lock_guard<std::mutex> lock(thread.mutex);
+        if (!thread.events.empty()) {
+            return;
+        }
+    }
+    std::vector<Event> events(std::max<size_t>(traceCapacity.load(std::memory_order_relaxed), 1));
+    std::lock_guard<std::mutex> lock(thread.mutex);
+    if (thread.events.empty()) {
+        thread.events.swap(events);
+        thread.next = 0;
+        thread.wrapped = false;
+    }
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(c));
+            out += code;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+std::string labelEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (c == '\n') {
+            out += "\\n";
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+#ifdef __linux__
+// /proc/self/task/<tid>/stat 第 14、15 个字段为用户态 / 内核态时间（时钟滴答）；
+// 第 2 个字段（线程名）可能含空格，从最后一个 ')' 之后开始解析
+bool readTaskStat(const std::filesystem::path& task, ThreadStats& stats) {
+    std::ifstream statFile(task / "stat");
+    std::string content;
+    if (!std::getline(statFile, content)) {
+        return false;
+    }
+    const size_t close = content.rfind(')');
+    if (close == std::string::npos) {
+        return false;
+    }
+    std::istringstream fields(content.substr(close + 2));
+    std::string skip;
+    for (int i = 3; i < 14; ++i) {
+        fields >> skip;
+    }
+    unsigned long long user = 0;
+    unsigned long long system = 0;
+    if (!(fields >> user >> system)) {
+        return false;
+    }
+    const double tick = static_cast<double>(::sysconf(_SC_CLK_TCK));
+    stats.userSeconds = static_cast<double>(user) / tick;
+    stats.systemSeconds = static_cast<double>(system) / tick;
+
+    std::ifstream statusFile(task / "status");
+    std::string key;
+    while (statusFile >> key) {
+        if (key == "voluntary_ctxt_switches:") {
+            statusFile >> stats.voluntarySwitches;
+        } else if (key == "nonvoluntary_ctxt_switches:") {
+            statusFile >> stats.involuntarySwitches;
+        }
+        statusFile.ignore(256, '\n');
+    }
+    return true;
+}
+#endif
+
+#ifdef _WIN32
+double fileTimeSeconds(const FILETIME& time) {
+    ULARGE_INTEGER value;
+    value.LowPart = time.dwLowDateTime;
+    value.HighPart = time.dwHighDateTime;
+    return static_cast<double>(value.QuadPart) * 1e-7;
+}
+#endif
+
+} // namespace
+
+Site::Site(const char* name) :
+    siteName(name),
+    calls(0),
+    total(0),
+    maximum(0) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.sites.push_back(this);
+}
+
+void Site::record(int64_t durationNs) {
+    const uint64_t duration = durationNs > 0 ? static_cast<uint64_t>(durationNs) : 0;
+    calls.fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(duration, std::memory_order_relaxed);
+    uint64_t previous = maximum.load(std::memory_order_relaxed);
+    while (duration > previous && !maximum.compare_exchange_weak(previous, duration, std::memory_order_relaxed)) {
+    }
+}
+
+const char* Site::name() const {
+    return siteName;
+}
+
+uint64_t Site::count() const {
+    return calls.load(std::memory_order_relaxed);
+}
+
+uint64_t Site::totalNs() const {
+    return total.load(std::memory_order_relaxed);
+}
+
+uint64_t Site::maxNs() const {
+    return maximum.load(std::memory_order_relaxed);
+}
+
+Zone::Zone(Site& site) :
+    site(site),
+    startNs(nowNs()) {
+}
+
+Zone::~Zone() {
+    const int64_t duration = nowNs() - startNs;
+    site.record(duration);
+    if (!tracing.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    ThreadState& thread = currentThread();
+    std::lock_guard<std::mutex> lock(thread.mutex);
+    if (thread.events.empty()) {
+        // 只有未命名、且在开启追踪之后才创建的线程会走到这里
+        thread.events.resize(std::max<size_t>(traceCapacity.load(std::memory_order_relaxed), 1));
+    }
+    thread.events[thread.next] = {&site, startNs, duration};
+    if (++thread.next == thread.events.size()) {
+        thread.next = 0;
+        thread.wrapped = true;
+    }
+}
+
+void setThreadName(const std::string& name) {
+    ThreadState& thread = currentThread();
+    {
+        std::lock_guard<std::mutex> lock(thread.mutex);
+        thread.name = name;
+    }
+    // 追踪进行中新建的线程在命名时分配；其余线程在开启追踪时统一分配，不追踪时不占内存
+    if (tracing.load(std::memory_order_relaxed)) {
+        reserveEvents(thread);
+    }
+#ifdef __linux__
+    ::pthread_setname_np(::pthread_self(), name.substr(0, 15).c_str());
+#endif
+}
+
+void setTracing(bool enabled) {
+    if (enabled) {
+        std::vector<std::shared_ptr<ThreadState>> threads;
+        {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            threads = r.threads;
+        }
+        for (const auto& thread : threads) {
+            reserveEvents(*thread);
+        }
+    }
+    tracing.store(enabled, std::memory_order_relaxed);
+}
+
+bool isTracing() {
+    return tracing.load(std::memory_order_relaxed);
+}
+
+void setTraceCapacity(size_t eventsPerThread) {
+    traceCapacity.store(std::max<size_t>(eventsPerThread, 1), std::memory_order_relaxed);
+}
+
+void clearTrace() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto& thread : r.threads) {
+        // 保留已分配的缓冲区，下次追踪不必在实时线程上重新分配
+        std::lock_guard<std::mutex> stateLock(thread->mutex);
+        thread->next = 0;
+        thread->wrapped = false;
+    }
+    r.threads.erase(std::remove_if(r.threads.begin(), r.threads.end(),
+                                   [](const auto& thread) { return !thread->alive; }),
+                    r.threads.end());
+}
+
+std::vector<ZoneStats> zoneStats() {
+    // 同名计时点（如不同文件中的 "send"）合并
+    std::map<std::string, ZoneStats> merged;
+    Registry& r = registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (const Site* site : r.sites) {
+            ZoneStats& stats = merged[site->name()];
+            stats.name = site->name();
+            stats.count += site->count();
+            stats.totalNs += site->totalNs();
+            stats.maxNs = std::max(stats.maxNs, site->maxNs());
+        }
+    }
+    std::vector<ZoneStats> result;
+    for (auto& [name, stats] : merged) {
+        result.push_back(std::move(stats));
+    }
+    return result;
+}
+
+std::vector<ThreadStats> threadStats() {
+    std::map<int64_t, std::string> names;
+    std::vector<ThreadStats> result;
+    Registry& r = registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (const auto& thread : r.threads) {
+            if (!thread->alive) {
+                continue;
+            }
+            std::lock_guard<std::mutex> stateLock(thread->mutex);
+            names[thread->id] = thread->name;
+#ifdef _WIN32
+            ThreadStats stats;
+            stats.id = thread->id;
+            stats.name = thread->name;
+            FILETIME creation, exit, kernel, user;
+            if (thread->handle && ::GetThreadTimes(thread->handle, &creation, &exit, &kernel, &user)) {
+                stats.userSeconds = fileTimeSeconds(user);
+                stats.systemSeconds = fileTimeSeconds(kernel);
+            }
+            result.push_back(stats);
+#elif !defined(__linux__)
+            ThreadStats stats;
+            stats.id = thread->id;
+            stats.name = thread->name;
+            result.push_back(stats);
+#endif
+        }
+    }
+
+#ifdef __linux__
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task", error)) {
+        ThreadStats stats;
+        try {
+            stats.id = std::stoll(entry.path().filename().string());
+        } catch (const std::exception&) {
+            continue;
+        }
+        // 线程可能在遍历期间退出
+        if (!readTaskStat(entry.path(), stats)) {
+            continue;
+        }
+        const auto named = names.find(stats.id);
+        if (named != names.end() && !named->second.empty()) {
+            stats.name = named->second;
+        } else {
+            std::ifstream comm(entry.path() / "comm");
+            std::getline(comm, stats.name);
+        }
+        result.push_back(stats);
+    }
+    std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) { return a.id < b.id; });
+#endif
+    return result;
+}
+
+ThreadStats processStats() {
+    ThreadStats stats;
+    stats.name = "process";
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (::GetProcessTimes(::GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        stats.userSeconds = fileTimeSeconds(user);
+        stats.systemSeconds = fileTimeSeconds(kernel);
+    }
+#else
+    rusage usage{};
+    if (::getrusage(RUSAGE_SELF, &usage) == 0) {
+        stats.userSeconds = static_cast<double>(usage.ru_utime.tv_sec) + static_cast<double>(usage.ru_utime.tv_usec) * 1e-6;
+        stats.systemSeconds = static_cast<double>(usage.ru_stime.tv_sec) + static_cast<double>(usage.ru_stime.tv_usec) * 1e-6;
+        stats.voluntarySwitches = static_cast<uint64_t>(usage.ru_nvcsw);
+        stats.involuntarySwitches = static_cast<uint64_t>(usage.ru_nivcsw);
+    }
+#endif
+    return stats;
+}
+
+std::string chromeTrace() {
+    struct Snapshot {
+        int64_t id = 0;
+        std::string name;
+        std::vector<Event> events;
+    };
+
+    // 持锁只做拷贝：各线程的事件按时间顺序取出（写满后从最旧的 next 开始），格式化放到锁外
+    std::vector<std::shared_ptr<ThreadState>> threads;
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        threads = r.threads;
+    }
+    std::vector<Snapshot> snapshots(threads.size());
+    for (size_t t = 0; t < threads.size(); ++t) {
+        ThreadState& thread = *threads[t];
+        Snapshot& snapshot = snapshots[t];
+        snapshot.id = thread.id;
+        std::lock_guard<std::mutex> stateLock(thread.mutex);
+        snapshot.name = thread.name;
+        const size_t size = thread.wrapped ? thread.events.size() : thread.next;
+        snapshot.events.reserve(size);
+        if (thread.wrapped) {
+            snapshot.events.insert(snapshot.events.end(), thread.events.begin() + static_cast<std::ptrdiff_t>(thread.next),
+                                   thread.events.end());
+        }
+        snapshot.events.insert(snapshot.events.end(), thread.events.begin(),
+                               thread.events.begin() + static_cast<std::ptrdiff_t>(thread.next));
+    }
+
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto append = [&](const char* text) {
+        if (!first) {
+            out += ',';
+        }
+        first = false;
+        out += '\n';
+        out += text;
+    };
+
+    char line[512];
+    for (const Snapshot& snapshot : snapshots) {
+        if (!snapshot.name.empty()) {
+            std::snprintf(line, sizeof(line),
+                          R"({"name":"thread_name","ph":"M","pid":1,"tid":%lld,"args":{"name":"%s"}})",
+                          static_cast<long long>(snapshot.id), jsonEscape(snapshot.name).c_str());
+            append(line);
+        }
+        for (const Event& event : snapshot.events) {
+            std::snprintf(line, sizeof(line),
+                          R"({"name":"%s","ph":"X","pid":1,"tid":%lld,"ts":%.3f,"dur":%.3f})",
+                          jsonEscape(event.site->name()).c_str(), static_cast<long long>(snapshot.id),
+                          static_cast<double>(event.startNs) / 1000.0, static_cast<double>(event.durationNs) / 1000.0);
+            append(line);
+        }
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+bool writeChromeTrace(const std::string& path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "profiler: cannot write " << path << std::endl;
+        return false;
+    }
+    file << chromeTrace();
+    return static_cast<bool>(file);
+}
+
+std::string metricsText() {
+    std::ostringstream out;
+    const std::vector<ZoneStats> zones = zoneStats();
+    out << "# TYPE controlry_zone_calls_total counter\n";
+    for (const auto& zone : zones) {
+        out << "controlry_zone_calls_total{zone=\"" << labelEscape(zone.name) << "\"} " << zone.count << '\n';
+    }
+    out << "# TYPE controlry_zone_seconds_total counter\n";
+    for (const auto& zone : zones) {
+        out << "controlry_zone_seconds_total{zone=\"" << labelEscape(zone.name) << "\"} "
+            << static_cast<double>(zone.totalNs) * 1e-9 << '\n';
+    }
+    out << "# TYPE controlry_zone_max_seconds gauge\n";
+    for (const auto& zone : zones) {
+        out << "controlry_zone_max_seconds{zone=\"" << labelEscape(zone.name) << "\"} "
+            << static_cast<double>(zone.maxNs) * 1e-9 << '\n';
+    }
+
+    const std::vector<ThreadStats> threads = threadStats();
+    out << "# TYPE controlry_thread_cpu_seconds_total counter\n";
+    for (const auto& thread : threads) {
+        const std::string labels = "thread=\"" + labelEscape(thread.name) + "\",tid=\"" + std::to_string(thread.id) + "\"";
+        out << "controlry_thread_cpu_seconds_total{" << labels << ",mode=\"user\"} " << thread.userSeconds << '\n';
+        out << "controlry_thread_cpu_seconds_total{" << labels << ",mode=\"system\"} " << thread.systemSeconds << '\n';
+    }
+    out << "# TYPE controlry_thread_context_switches_total counter\n";
+    for (const auto& thread : threads) {
+        const std::string labels = "thread=\"" + labelEscape(thread.name) + "\",tid=\"" + std::to_string(thread.id) + "\"";
+        out << "controlry_thread_context_switches_total{" << labels << ",kind=\"voluntary\"} "
+            << thread.voluntarySwitches << '\n';
+        out << "controlry_thread_context_switches_total{" << labels << ",kind=\"involuntary\"} "
+            << thread.involuntarySwitches << '\n';
+    }
+
+    const ThreadStats process = processStats();
+    out << "# TYPE controlry_process_cpu_seconds_total counter\n";
+    out << "controlry_process_cpu_seconds_total{mode=\"user\"} " << process.userSeconds << '\n';
+    out << "controlry_process_cpu_seconds_total{mode=\"system\"} " << process.systemSeconds << '\n';
+    out << "# TYPE controlry_process_context_switches_total counter\n";
+    out << "controlry_process_context_switches_total{kind=\"voluntary\"} " << process.voluntarySwitches << '\n';
+    out << "controlry_process_context_switches_total{kind=\"involuntary\"} " << process.involuntarySwitches << '\n';
+    out << "# TYPE controlry_tracing gauge\n";
+    out << "controlry_tracing " << (isTracing() ? 1 : 0) << '\n';
+    return out.str();
+}
+
+namespace {
+
+bool sendAll(socket_t sock, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const auto n = ::send(sock, data.data() + sent, static_cast<int>(data.size() - sent), SOCKET_SEND_FLAGS);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void respond(socket_t sock, const char* status, const char* contentType, const std::string& body) {
+    std::string response = std::string("HTTP/1.1 ") + status + "\r\nContent-Type: " + contentType +
+                           "\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n";
+    response += body;
+    sendAll(sock, response);
+}
+
+// 读到请求头结束或超时，返回请求路径（不含查询串），出错返回空串
+std::string readRequestPath(socket_t sock) {
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+        pollfd_t pfd{};
+        pfd.fd = sock;
+        pfd.events = POLLIN;
+        if (pollSockets(&pfd, 1, 1000) <= 0) {
+            return {};
+        }
+        const auto n = ::recv(sock, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            return {};
+        }
+        request.append(buffer, static_cast<size_t>(n));
+    }
+
+    std::istringstream line(request.substr(0, request.find("\r\n")));
+    std::string method, target;
+    if (!(line >> method >> target) || method != "GET") {
+        return {};
+    }
+    return target.substr(0, target.find('?'));
+}
+
+} // namespace
+
+MetricsServer::MetricsServer() :
+    listener(static_cast<std::intptr_t>(INVALID_SOCKET_HANDLE)),
+    running(false) {
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+bool MetricsServer::start(int port, bool loopbackOnly) {
+    if (running) {
+        return true;
+    }
+    initializeSockets();
+
+    socket_t server = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (server == INVALID_SOCKET_HANDLE) {
+        std::cerr << "MetricsServer: cannot create socket" << std::endl;
+        return false;
+    }
+    int reuse = 1;
+    ::setsockopt(server, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(loopbackOnly ? INADDR_LOOPBACK : INADDR_ANY);
+    if (::bind(server, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(server, 8) != 0) {
+        std::cerr << "MetricsServer: cannot listen on port " << port << std::endl;
+        closeSocket(server);
+        return false;
+    }
+
+    listener = static_cast<std::intptr_t>(server);
+    running = true;
+    thread = std::thread(&MetricsServer::run, this);
+    std::cout << "Metrics endpoint on http://" << (loopbackOnly ? "127.0.0.1" : "0.0.0.0") << ':' << port
+              << "/metrics" << std::endl;
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+    closeSocket(static_cast<socket_t>(listener));
+    listener = static_cast<std::intptr_t>(INVALID_SOCKET_HANDLE);
+}
+
+bool MetricsServer::isRunning() const {
+    return running;
+}
+
+void MetricsServer::run() {
+    setThreadName("metrics");
+    const socket_t server = static_cast<socket_t>(listener);
+    while (running) {
+        pollfd_t pfd{};
+        pfd.fd = server;
+        pfd.events = POLLIN;
+        if (pollSockets(&pfd, 1, 200) <= 0) {
+            continue;
+        }
+        const socket_t client = ::accept(server, nullptr, nullptr);
+        if (client == INVALID_SOCKET_HANDLE) {
+            continue;
+        }
+
+        const std::string path = readRequestPath(client);
+        if (path == "/metrics") {
+            respond(client, "200 OK", "text/plain; version=0.0.4", metricsText());
+        } else if (path == "/trace") {
+            respond(client, "200 OK", "application/json", chromeTrace());
+        } else if (path == "/trace/start") {
+            clearTrace();
+            setTracing(true);
+            respond(client, "200 OK", "text/plain", "tracing started\n");
+        } else if (path == "/trace/stop") {
+            setTracing(false);
+            respond(client, "200 OK", "text/plain", "tracing stopped\n");
+        } else if (path.empty()) {
+            respond(client, "400 Bad Request", "text/plain", "bad request\n");
+        } else {
+            respond(client, "404 Not Found", "text/plain", "endpoints: /metrics /trace /trace/start /trace/stop\n");
+        }
+        closeSocket(client);
+    }
+}
+
+} // namespace profiler
@@ -0,0 +1,88 @@
+#include "protocol.h"
+
+// 硬件 CRC32C：x86-64 上需以 -msse4.2（或 MSVC /arch:AVX）编译，ARMv8 需带 CRC 扩展
+#if (defined(__SSE4_2__) || defined(__AVX__)) && (defined(__x86_64__) || defined(_M_X64))
+#define CRC32C_SSE42 1
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#define CRC32C_ARM 1
+#include <arm_acle.h>
+#endif
+
+namespace protocol {
+
+namespace {
+
+constexpr std::array<uint16_t, 256> CRC16_TABLE = [] {
+    std::array<uint16_t, 256> table{};
+    for (unsigned i = 0; i < 256; ++i) {
+        uint16_t crc = static_cast<uint16_t>(i << 8);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}();
+
+// 反射多项式 0x82F63B78
+constexpr std::array<uint32_t, 256> CRC32C_TABLE = [] {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}();
+
+} // namespace
+
+uint16_t crc16(const uint8_t* data, size_t size) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < size; ++i) {
+        crc = static_cast<uint16_t>((crc << 8) ^ CRC16_TABLE[((crc >> 8) ^ data[i]) & 0xFF]);
+    }
+    return crc;
+}
+
+uint32_t crc32cSoftware(const uint8_t* data, size_t size) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = (crc >> 8) ^ CRC32C_TABLE[(crc ^ data[i]) & 0xFF];
+    }
+    return ~crc;
+}
+
+uint32_t crc32c(const uint8_t* data, size_t size) {
+#if defined(CRC32C_SSE42)
+    uint64_t crc = 0xFFFFFFFFu;
+    for (; size >= 8; size -= 8, data += 8) {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        crc = _mm_crc32_u64(crc, word);
+    }
+    uint32_t crc32 = static_cast<uint32_t>(crc);
+    for (; size > 0; --size, ++data) {
+        crc32 = _mm_crc32_u8(crc32, *data);
+    }
+    return ~crc32;
+#elif defined(CRC32C_ARM)
+    uint32_t crc = 0xFFFFFFFFu;
+    for (; size >= 8; size -= 8, data += 8) {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        crc = __crc32cd(crc, word);
+    }
+    for (; size > 0; --size, ++data) {
+        crc = __crc32cb(crc, *data);
+    }
+    return ~crc;
+#else
+    return crc32cSoftware(data, size);
+#endif
+}
+
+} // namespace protocol
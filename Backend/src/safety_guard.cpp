@@ -0,0 +1,131 @@
+#include "safety_guard.h"
+#include <algorithm>
+#include <cmath>
+
+std::atomic<bool> SafetyGuard::estop(false);
+
+namespace {
+
+// 计数器只由发送线程写入，无需原子读-改-写；只在条件由不成立变为成立时计数
+void trip(bool& active, bool triggered, std::atomic<uint64_t>& counter) {
+    if (triggered && !active) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    active = triggered;
+}
+
+} // namespace
+
+SafetyGuard::SafetyGuard() :
+    maxTorque(0.0f),
+    maxSlewRate(0.0f),
+    minAngle(0.0f),
+    maxAngle(0.0f),
+    feedbackTimeoutNs(0),
+    feedbackTimeouts(0),
+    torqueClamps(0),
+    slewClamps(0),
+    envelopeTrips(0),
+    emergencyStops(0),
+    lastOutput(0.0f),
+    lastNs(0),
+    emergencyStopActive(false),
+    feedbackTimeoutActive(false),
+    torqueClampActive(false),
+    slewClampActive(false),
+    envelopeActive(false) {
+    setLimits(SafetyLimits{});
+}
+
+void SafetyGuard::setLimits(const SafetyLimits& limits) {
+    maxTorque.store(limits.maxTorque, std::memory_order_relaxed);
+    maxSlewRate.store(limits.maxSlewRate, std::memory_order_relaxed);
+    minAngle.store(limits.minAngle, std::memory_order_relaxed);
+    maxAngle.store(limits.maxAngle, std::memory_order_relaxed);
+    feedbackTimeoutNs.store(static_cast<int64_t>(static_cast<double>(limits.feedbackTimeout) * 1e9),
+                            std::memory_order_relaxed);
+}
+
+SafetyLimits SafetyGuard::limits() const {
+    SafetyLimits limits;
+    limits.maxTorque = maxTorque.load(std::memory_order_relaxed);
+    limits.maxSlewRate = maxSlewRate.load(std::memory_order_relaxed);
+    limits.minAngle = minAngle.load(std::memory_order_relaxed);
+    limits.maxAngle = maxAngle.load(std::memory_order_relaxed);
+    limits.feedbackTimeout = static_cast<float>(static_cast<double>(feedbackTimeoutNs.load(std::memory_order_relaxed)) * 1e-9);
+    return limits;
+}
+
+SafetyStats SafetyGuard::stats() const {
+    SafetyStats stats;
+    stats.feedbackTimeouts = feedbackTimeouts.load(std::memory_order_relaxed);
+    stats.torqueClamps = torqueClamps.load(std::memory_order_relaxed);
+    stats.slewClamps = slewClamps.load(std::memory_order_relaxed);
+    stats.envelopeTrips = envelopeTrips.load(std::memory_order_relaxed);
+    stats.emergencyStops = emergencyStops.load(std::memory_order_relaxed);
+    return stats;
+}
+
+float SafetyGuard::apply(float torque, double position, int64_t feedbackAgeNs, int64_t nowNs) {
+    const float dt = lastNs > 0 ? static_cast<float>(nowNs - lastNs) * 1e-9f : 0.0f;
+    lastNs = nowNs;
+
+    // 急停与反馈看门狗直接切断输出，不经过变化率限制；恢复后从零开始爬升
+    const bool stopped = estop.load(std::memory_order_relaxed);
+    const int64_t timeoutNs = feedbackTimeoutNs.load(std::memory_order_relaxed);
+    const bool timedOut = !stopped && timeoutNs > 0 && (feedbackAgeNs < 0 || feedbackAgeNs > timeoutNs);
+    trip(emergencyStopActive, stopped, emergencyStops);
+    trip(feedbackTimeoutActive, timedOut, feedbackTimeouts);
+    if (stopped || timedOut) {
+        torqueClampActive = false;
+        envelopeActive = false;
+        slewClampActive = false;
+        lastOutput = 0.0f;
+        return 0.0f;
+    }
+
+    // NaN 视为超限
+    const float limit = maxTorque.load(std::memory_order_relaxed);
+    const bool finite = std::isfinite(torque);
+    trip(torqueClampActive, !finite || (limit > 0.0f && std::abs(torque) > limit), torqueClamps);
+    if (!finite) {
+        torque = 0.0f;
+    } else if (limit > 0.0f) {
+        torque = std::clamp(torque, -limit, limit);
+    }
+
+    // 位置包络：越界后只保留把电机推回包络内的分量。与急停一样立即切断、不经过变化率限制，
+    // 否则向外的力矩要按斜率慢慢降下来，期间电机继续被推出包络
+    const double lo = minAngle.load(std::memory_order_relaxed);
+    const double hi = maxAngle.load(std::memory_order_relaxed);
+    const bool outside = lo < hi && ((position > hi && torque > 0.0f) || (position < lo && torque < 0.0f));
+    trip(envelopeActive, outside, envelopeTrips);
+    if (outside) {
+        slewClampActive = false;
+        lastOutput = 0.0f;
+        return 0.0f;
+    }
+
+    const float rate = maxSlewRate.load(std::memory_order_relaxed);
+    const float step = rate * dt;
+    const bool limited = rate > 0.0f && dt > 0.0f && std::abs(torque - lastOutput) > step;
+    trip(slewClampActive, limited, slewClamps);
+    if (limited) {
+        torque = std::clamp(torque, lastOutput - step, lastOutput + step);
+    }
+
+    lastOutput = torque;
+    return torque;
+}
+
+void SafetyGuard::emergencyStop() {
+    estop.store(true);
+}
+
+void SafetyGuard::clearEmergencyStop() {
+    estop.store(false);
+}
+
+bool SafetyGuard::isEmergencyStopped() {
+    return estop.load();
+}
@@ -0,0 +1,209 @@
+#include "serial_transport.h"
+#include <iostream>
+#include <utility>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/serial.h>
+#endif
+
+namespace {
+
+speed_t toSpeed(int baudRate) {
+    switch (baudRate) {
+        case 9600:    return B9600;
+        case 19200:   return B19200;
+        case 38400:   return B38400;
+        case 57600:   return B57600;
+        case 115200:  return B115200;
+        case 230400:  return B230400;
+#ifdef B460800
+        case 460800:  return B460800;
+#endif
+#ifdef B921600
+        case 921600:  return B921600;
+#endif
+#ifdef B1000000
+        case 1000000: return B1000000;
+#endif
+#ifdef B1500000
+        case 1500000: return B1500000;
+#endif
+#ifdef B2000000
+        case 2000000: return B2000000;
+#endif
+#ifdef B3000000
+        case 3000000: return B3000000;
+#endif
+#ifdef B4000000
+        case 4000000: return B4000000;
+#endif
+        default:      return B0;
+    }
+}
+
+} // namespace
+#endif
+
+SerialTransport::SerialTransport(std::string device) :
+    SerialTransport(std::move(device), Options{}) {
+}
+
+SerialTransport::SerialTransport(std::string device, const Options& options) :
+    device(std::move(device)),
+    options(options),
+    fd(-1) {
+}
+
+SerialTransport::~SerialTransport() {
+    close();
+}
+
+#ifndef _WIN32
+
+bool SerialTransport::open() {
+    if (fd >= 0) {
+        return true;
+    }
+
+    const speed_t speed = toSpeed(options.baudRate);
+    if (speed == B0) {
+        std::cerr << "Unsupported baud rate " << options.baudRate << " for " << device << std::endl;
+        return false;
+    }
+
+    fd = ::open(device.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Failed to open serial device " << device << "." << std::endl;
+        return false;
+    }
+
+    termios tty{};
+    if (tcgetattr(fd, &tty) != 0) {
+        std::cerr << "tcgetattr failed on " << device << "." << std::endl;
+        close();
+        return false;
+    }
+
+    // 原始模式 8N1，无流控
+    cfmakeraw(&tty);
+    tty.c_cflag |= CLOCAL | CREAD;
+    tty.c_cflag &= ~(CSTOPB | PARENB);
+#ifdef CRTSCTS
+    tty.c_cflag &= ~CRTSCTS;
+#endif
+    tty.c_cc[VMIN] = static_cast<cc_t>(options.vmin);
+    tty.c_cc[VTIME] = static_cast<cc_t>(options.vtime);
+    cfsetispeed(&tty, speed);
+    cfsetospeed(&tty, speed);
+
+    if (tcsetattr(fd, TCSANOW, &tty) != 0) {
+        std::cerr << "tcsetattr failed on " << device << "." << std::endl;
+        close();
+        return false;
+    }
+
+#ifdef __linux__
+    // 低延时模式：USB 转串口芯片默认会攒数据再上报，尽力关闭（pty 等设备不支持时忽略）
+    if (options.lowLatency) {
+        serial_struct serial{};
+        if (ioctl(fd, TIOCGSERIAL, &serial) == 0) {
+            serial.flags |= ASYNC_LOW_LATENCY;
+            ioctl(fd, TIOCSSERIAL, &serial);
+        }
+    }
+#endif
+
+    if (!options.nonBlocking) {
+        const int flags = fcntl(fd, F_GETFL);
+        fcntl(fd, F_SETFL, flags & ~O_NONBLOCK);
+    }
+
+    tcflush(fd, TCIOFLUSH);
+    return true;
+}
+
+void SerialTransport::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+bool SerialTransport::send(const uint8_t* data, size_t size) {
+    while (size > 0) {
+        const ssize_t written = ::write(fd, data, size);
+        if (written > 0) {
+            data += written;
+            size -= static_cast<size_t>(written);
+            continue;
+        }
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            pollfd pfd{fd, POLLOUT, 0};
+            if (::poll(&pfd, 1, 100) <= 0) {
+                return false;
+            }
+            continue;
+        }
+        return false;
+    }
+    return true;
+}
+
+int SerialTransport::receive(uint8_t* data, size_t size, int timeoutMs) {
+    pollfd pfd{fd, POLLIN, 0};
+    const int ready = ::poll(&pfd, 1, timeoutMs);
+    if (ready == 0 || (ready < 0 && errno == EINTR)) {
+        return 0;
+    }
+    if (ready < 0 || (pfd.revents & (POLLERR | POLLNVAL))) {
+        return -1;
+    }
+
+    const ssize_t received = ::read(fd, data, size);
+    if (received > 0) {
+        return static_cast<int>(received);
+    }
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        return 0;
+    }
+    // 读到 0 字节说明设备已挂断（USB 拔出 / pty 对端关闭）
+    return -1;
+}
+
+#else
+
+bool SerialTransport::open() {
+    std::cerr << "Serial transport is not supported on this platform." << std::endl;
+    return false;
+}
+
+void SerialTransport::close() {
+}
+
+bool SerialTransport::send(const uint8_t*, size_t) {
+    return false;
+}
+
+int SerialTransport::receive(uint8_t*, size_t, int) {
+    return -1;
+}
+
+#endif
+
+bool SerialTransport::isOpen() const {
+    return fd >= 0;
+}
+
+std::string SerialTransport::describe() const {
+    return "serial://" + device + "?baud=" + std::to_string(options.baudRate);
+}
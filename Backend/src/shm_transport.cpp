@@ -0,0 +1,408 @@
+#include "shm_transport.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+#ifndef _WIN32
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+#ifndef _WIN32
+
+namespace {
+
+constexpr uint32_t SEGMENT_MAGIC = 0x43534D32;  // "CSM2"，段头加入进程号
+constexpr size_t SEND_TIMEOUT_MS = 100;
+constexpr int64_t LIVENESS_PERIOD_NS = 100'000'000;  // 检查对方进程是否存活的间隔
+
+// 两个进程各自映射同一段内存，原子量必须无锁，否则锁在各自进程内
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+enum PeerState : uint32_t {
+    DETACHED = 0,  // 尚未连上
+    ATTACHED = 1,
+    CLOSED = 2
+};
+
+enum RingIndex : size_t {
+    COMMAND_RING = 0,   // 上位机 → 设备
+    FEEDBACK_RING = 1   // 设备 → 上位机
+};
+
+} // namespace
+
+// 生产者与消费者各写各的缓存行，避免伪共享
+struct ShmRing {
+    alignas(64) std::atomic<uint64_t> tail;      // 生产者写入的累计字节数
+    alignas(64) std::atomic<uint64_t> head;      // 消费者读走的累计字节数
+    alignas(64) std::atomic<uint32_t> sequence;  // futex 字：每次写入后递增
+    std::atomic<uint32_t> waiting;               // 正在 futex 等待的消费者数
+};
+
+struct ShmSegment {
+    std::atomic<uint32_t> magic;
+    uint32_t reserved;
+    uint64_t capacity;
+    std::atomic<uint32_t> state[2];  // 按 Role 索引
+    std::atomic<uint32_t> owner[2];  // 各方进程号，按 Role 索引
+    ShmRing rings[2];
+
+    uint8_t* data(size_t ring) {
+        return reinterpret_cast<uint8_t*>(this + 1) + ring * capacity;
+    }
+};
+
+namespace {
+
+size_t segmentSize(size_t capacity) {
+    return sizeof(ShmSegment) + 2 * capacity;
+}
+
+size_t roundUpPowerOfTwo(size_t value) {
+    size_t result = 64;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+size_t roleIndex(ShmTransport::Role role) {
+    return role == ShmTransport::Role::CONTROLLER ? 0 : 1;
+}
+
+void futexWait(std::atomic<uint32_t>& word, uint32_t expected, int64_t timeoutNs) {
+#ifdef __linux__
+    // 共享内存跨进程，不能用 FUTEX_PRIVATE_FLAG
+    timespec timeout{static_cast<time_t>(timeoutNs / 1'000'000'000), static_cast<long>(timeoutNs % 1'000'000'000)};
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+#else
+    (void)expected;
+    std::this_thread::sleep_for(std::chrono::nanoseconds(std::min<int64_t>(timeoutNs, 50'000)));
+#endif
+}
+
+void futexWake(std::atomic<uint32_t>& word) {
+#ifdef __linux__
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool processAlive(uint32_t pid) {
+    // EPERM 说明进程存在只是无权发信号
+    return pid == 0 || ::kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH;
+}
+
+// 段中是否有存活的使用者：任一方标记为已连上且进程仍在
+bool segmentInUse(const ShmSegment& segment) {
+    for (size_t role = 0; role < 2; ++role) {
+        if (segment.state[role].load() == ATTACHED && processAlive(segment.owner[role].load())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void wakeRing(ShmRing& ring) {
+    ring.sequence.fetch_add(1);
+    if (ring.waiting.load() > 0) {
+        futexWake(ring.sequence);
+    }
+}
+
+} // namespace
+
+#endif
+
+ShmTransport::ShmTransport(std::string name) :
+    ShmTransport(std::move(name), Options{}) {
+}
+
+ShmTransport::ShmTransport(std::string name, const Options& options) :
+    name(name.empty() || name[0] != '/' ? "/" + name : std::move(name)),
+    options(options),
+    segment(nullptr),
+    mappedSize(0),
+    created(false),
+    nextLivenessCheckNs(0) {
+}
+
+ShmTransport::~ShmTransport() {
+    close();
+}
+
+bool ShmTransport::isOpen() const {
+    return segment != nullptr;
+}
+
+std::string ShmTransport::describe() const {
+    return "shm://" + name.substr(1) + (options.role == Role::CONTROLLER ? " (controller)" : " (device)");
+}
+
+#ifndef _WIN32
+
+bool ShmTransport::open() {
+    if (segment) {
+        return true;
+    }
+    bool stale = false;
+    if (openSegment(stale)) {
+        return true;
+    }
+    if (!stale) {
+        return false;
+    }
+    // 上次运行遗留的段：删除后重新创建
+    std::cerr << "Shared memory " << name << " has no live users, recreating it." << std::endl;
+    ::shm_unlink(name.c_str());
+    return openSegment(stale);
+}
+
+bool ShmTransport::openSegment(bool& stale) {
+    stale = false;
+
+    // 先尝试创建；已存在则打开，并等待创建方写完段头
+    created = true;
+    int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        created = false;
+        fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+    }
+    if (fd < 0) {
+        std::cerr << "Failed to open shared memory " << name << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    size_t capacity = roundUpPowerOfTwo(options.capacity);
+    if (created) {
+        if (::ftruncate(fd, static_cast<off_t>(segmentSize(capacity))) != 0) {
+            std::cerr << "Failed to size shared memory " << name << ": " << std::strerror(errno) << std::endl;
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return false;
+        }
+    } else {
+        const int64_t deadline = steadyNowNs() + static_cast<int64_t>(options.attachTimeoutMs) * 1'000'000;
+        bool ready = false;
+        while (!ready && steadyNowNs() < deadline) {
+            struct stat info{};
+            if (::fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(ShmSegment)) {
+                void* header = ::mmap(nullptr, sizeof(ShmSegment), PROT_READ, MAP_SHARED, fd, 0);
+                if (header != MAP_FAILED) {
+                    const auto* view = static_cast<const ShmSegment*>(header);
+                    if (view->magic.load(std::memory_order_acquire) == SEGMENT_MAGIC &&
+                        static_cast<size_t>(info.st_size) >= segmentSize(view->capacity)) {
+                        capacity = view->capacity;
+                        ready = true;
+                    }
+                    ::munmap(header, sizeof(ShmSegment));
+                }
+            }
+            if (!ready) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        if (!ready) {
+            // 创建方在初始化完成前退出，或是旧版本的段
+            ::close(fd);
+            stale = true;
+            return false;
+        }
+    }
+
+    const size_t size = segmentSize(capacity);
+    void* mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        std::cerr << "Failed to map shared memory " << name << ": " << std::strerror(errno) << std::endl;
+        if (created) {
+            ::shm_unlink(name.c_str());
+        }
+        return false;
+    }
+
+    auto* opened = static_cast<ShmSegment*>(mapped);
+    if (created) {
+        // ftruncate 后内容全零，原子量的零值即初始状态
+        opened->capacity = capacity;
+        opened->magic.store(SEGMENT_MAGIC, std::memory_order_release);
+    } else if (!segmentInUse(*opened)) {
+        ::munmap(mapped, size);
+        stale = true;
+        return false;
+    }
+
+    segment = opened;
+    mappedSize = size;
+
+    // 丢弃上一次连接遗留在接收环中的数据（只有消费者写 head）
+    ShmRing& inbound = segment->rings[options.role == Role::CONTROLLER ? FEEDBACK_RING : COMMAND_RING];
+    inbound.head.store(inbound.tail.load());
+    segment->owner[roleIndex(options.role)].store(static_cast<uint32_t>(::getpid()));
+    segment->state[roleIndex(options.role)].store(ATTACHED);
+    nextLivenessCheckNs.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+bool ShmTransport::peerAlive() {
+    const size_t peer = 1 - roleIndex(options.role);
+    const uint32_t state = segment->state[peer].load();
+    if (state != ATTACHED) {
+        return state != CLOSED;
+    }
+    const int64_t now = steadyNowNs();
+    if (now < nextLivenessCheckNs.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    nextLivenessCheckNs.store(now + LIVENESS_PERIOD_NS, std::memory_order_relaxed);
+    if (processAlive(segment->owner[peer].load())) {
+        return true;
+    }
+    // 对方未经 close 就退出：代它标记关闭，之后的检查不必再发信号
+    segment->state[peer].store(CLOSED);
+    return false;
+}
+
+void ShmTransport::close() {
+    if (!segment) {
+        return;
+    }
+
+    // 标记关闭并唤醒对方，对方 receive 随即返回 -1
+    segment->state[roleIndex(options.role)].store(CLOSED);
+    wakeRing(segment->rings[COMMAND_RING]);
+    wakeRing(segment->rings[FEEDBACK_RING]);
+
+    ::munmap(segment, mappedSize);
+    segment = nullptr;
+    mappedSize = 0;
+    if (created) {
+        ::shm_unlink(name.c_str());
+        created = false;
+    }
+}
+
+bool ShmTransport::send(const uint8_t* data, size_t size) {
+    if (!segment) {
+        return false;
+    }
+    if (!peerAlive()) {
+        return false;
+    }
+    if (segment->state[1 - roleIndex(options.role)].load() == DETACHED) {
+        return true;
+    }
+
+    ShmRing& ring = segment->rings[options.role == Role::CONTROLLER ? COMMAND_RING : FEEDBACK_RING];
+    const size_t capacity = segment->capacity;
+    if (size > capacity) {
+        return false;
+    }
+
+    const uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+    const int64_t deadline = steadyNowNs() + static_cast<int64_t>(SEND_TIMEOUT_MS) * 1'000'000;
+    while (capacity - (tail - ring.head.load(std::memory_order_acquire)) < size) {
+        if (steadyNowNs() >= deadline || !peerAlive()) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+
+    const size_t offset = static_cast<size_t>(tail) & (capacity - 1);
+    const size_t first = std::min(size, capacity - offset);
+    uint8_t* buffer = segment->data(options.role == Role::CONTROLLER ? COMMAND_RING : FEEDBACK_RING);
+    std::memcpy(buffer + offset, data, first);
+    std::memcpy(buffer, data + first, size - first);
+    ring.tail.store(tail + size);
+    wakeRing(ring);
+    return true;
+}
+
+int ShmTransport::receive(uint8_t* data, size_t size, int timeoutMs) {
+    if (!segment) {
+        return -1;
+    }
+
+    const size_t index = options.role == Role::CONTROLLER ? FEEDBACK_RING : COMMAND_RING;
+    ShmRing& ring = segment->rings[index];
+    const size_t capacity = segment->capacity;
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    const int64_t start = steadyNowNs();
+    const int64_t deadline = start + static_cast<int64_t>(timeoutMs) * 1'000'000;
+    const int64_t spinUntil = start + static_cast<int64_t>(options.spinUs) * 1'000;
+
+    while (true) {
+        // futex 字须在检查环之前读取：之后的写入必然改变它，等待不会错过唤醒
+        const uint32_t sequence = ring.sequence.load();
+        const uint64_t available = ring.tail.load() - head;
+        if (available > 0) {
+            const size_t count = static_cast<size_t>(std::min<uint64_t>(available, size));
+            const size_t offset = static_cast<size_t>(head) & (capacity - 1);
+            const size_t first = std::min(count, capacity - offset);
+            const uint8_t* buffer = segment->data(index);
+            std::memcpy(data, buffer + offset, first);
+            std::memcpy(data + first, buffer, count - first);
+            ring.head.store(head + count, std::memory_order_release);
+            return static_cast<int>(count);
+        }
+        if (!peerAlive()) {
+            return -1;
+        }
+
+        const int64_t now = steadyNowNs();
+        if (now >= deadline) {
+            return 0;
+        }
+        if (options.busyPoll || now < spinUntil) {
+            continue;
+        }
+
+        // 等待不超过存活检查间隔，对方进程退出时不会一直睡到超时
+        ring.waiting.fetch_add(1);
+        if (ring.tail.load() == head) {
+            futexWait(ring.sequence, sequence, std::min(deadline - now, LIVENESS_PERIOD_NS));
+        }
+        ring.waiting.fetch_sub(1);
+    }
+}
+
+#else
+
+bool ShmTransport::open() {
+    std::cerr << "Shared memory transport is not supported on this platform." << std::endl;
+    return false;
+}
+
+void ShmTransport::close() {
+}
+
+bool ShmTransport::send(const uint8_t*, size_t) {
+    return false;
+}
+
+int ShmTransport::receive(uint8_t*, size_t, int) {
+    return -1;
+}
+
+#endif
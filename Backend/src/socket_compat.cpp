@@ -0,0 +1,55 @@
+#include "socket_compat.h"
+#include "transport.h"
+#include <iostream>
+
+namespace {
+
+bool setOption(socket_t sock, int level, int name, int value, const char* label) {
+    if (setsockopt(sock, level, name, reinterpret_cast<const char*>(&value), sizeof(value)) != 0) {
+        std::cerr << "Warning: failed to set " << label << "=" << value << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool applySocketOptions(socket_t sock, const TransportOptions& options, bool stream) {
+    bool ok = true;
+
+    if (stream) {
+        ok &= setOption(sock, IPPROTO_TCP, TCP_NODELAY, options.tcpNoDelay ? 1 : 0, "TCP_NODELAY");
+#ifdef TCP_QUICKACK
+        if (options.quickAck) {
+            ok &= setOption(sock, IPPROTO_TCP, TCP_QUICKACK, 1, "TCP_QUICKACK");
+        }
+#endif
+    }
+
+    if (options.sendBufferSize > 0) {
+        ok &= setOption(sock, SOL_SOCKET, SO_SNDBUF, options.sendBufferSize, "SO_SNDBUF");
+    }
+    if (options.receiveBufferSize > 0) {
+        ok &= setOption(sock, SOL_SOCKET, SO_RCVBUF, options.receiveBufferSize, "SO_RCVBUF");
+    }
+#ifdef SO_BUSY_POLL
+    if (options.busyPollUs > 0) {
+        ok &= setOption(sock, SOL_SOCKET, SO_BUSY_POLL, options.busyPollUs, "SO_BUSY_POLL");
+    }
+#endif
+#ifdef SO_PRIORITY
+    if (options.priority >= 0) {
+        ok &= setOption(sock, SOL_SOCKET, SO_PRIORITY, options.priority, "SO_PRIORITY");
+    }
+#endif
+    return ok;
+}
+
+void refreshQuickAck(socket_t sock) {
+#ifdef TCP_QUICKACK
+    int value = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_QUICKACK, reinterpret_cast<const char*>(&value), sizeof(value));
+#else
+    (void)sock;
+#endif
+}
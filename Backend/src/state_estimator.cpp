@@ -0,0 +1,229 @@
+#include "state_estimator.h"
+#include <algorithm>
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr double RAD_PER_DEG = PI / 180.0;
+constexpr double DEG_PER_RAD = 180.0 / PI;
+
+// 角加速度初始方差，初始化时加速度未知
+constexpr float INITIAL_ACCEL_VARIANCE = 1.0e4f;
+// 两帧间隔超过该值视为反馈中断，重新初始化
+constexpr float MAX_GAP = 0.5f;
+
+// 测量噪声方差（弧度制）
+struct Noise {
+    float angle;
+    float omega;
+};
+
+Noise noiseOf(const EstimatorConfig& config) {
+    const float angle = static_cast<float>(config.angleNoise * RAD_PER_DEG);
+    return {angle * angle, config.omegaNoise * config.omegaNoise};
+}
+
+// 状态转移 F = [[1, T, T²/2], [0, 1, T], [0, 0, 1]] 与白噪声加加速度对应的离散过程噪声 Q
+struct Transition {
+    float t;
+    float h;
+    float q00, q01, q02, q11, q12, q22;
+};
+
+Transition transitionOf(float dt, float jerkDensity) {
+    const float t2 = dt * dt;
+    const float t3 = t2 * dt;
+    const float q = jerkDensity;
+    return {dt, 0.5f * t2,
+            q * t3 * t2 / 20.0f, q * t2 * t2 / 8.0f, q * t3 / 6.0f,
+            q * t3 / 3.0f, q * t2 / 2.0f, q * dt};
+}
+
+// 一次预测 + 角度、角速度两次标量更新；P 为对称阵上三角 a b c / d e / f
+inline void kalmanStep(double& x0, float& x1, float& x2,
+                       float& a, float& b, float& c, float& d, float& e, float& f,
+                       double zAngle, float zOmega, const Transition& tr, const Noise& noise) {
+    // 预测：x = F x，P = F P Fᵀ + Q
+    x0 += tr.t * x1 + tr.h * x2;
+    x1 += tr.t * x2;
+
+    const float r00 = a + tr.t * b + tr.h * c;
+    const float r01 = b + tr.t * d + tr.h * e;
+    const float r02 = c + tr.t * e + tr.h * f;
+    const float r11 = d + tr.t * e;
+    const float r12 = e + tr.t * f;
+    a = r00 + tr.t * r01 + tr.h * r02 + tr.q00;
+    b = r01 + tr.t * r02 + tr.q01;
+    c = r02 + tr.q02;
+    d = r11 + tr.t * r12 + tr.q11;
+    e = r12 + tr.q12;
+    f = f + tr.q22;
+
+    // 角度观测
+    {
+        const float y = static_cast<float>(zAngle - x0);
+        const float s = a + noise.angle;
+        const float k0 = a / s;
+        const float k1 = b / s;
+        const float k2 = c / s;
+        x0 += k0 * y;
+        x1 += k1 * y;
+        x2 += k2 * y;
+        const float pa = a, pb = b, pc = c;
+        a -= k0 * pa;
+        b -= k0 * pb;
+        c -= k0 * pc;
+        d -= k1 * pb;
+        e -= k1 * pc;
+        f -= k2 * pc;
+    }
+
+    // 角速度观测
+    {
+        const float y = zOmega - x1;
+        const float s = d + noise.omega;
+        const float k0 = b / s;
+        const float k1 = d / s;
+        const float k2 = e / s;
+        x0 += k0 * y;
+        x1 += k1 * y;
+        x2 += k2 * y;
+        const float pb = b, pd = d, pe = e;
+        a -= k0 * pb;
+        b -= k0 * pd;
+        c -= k0 * pe;
+        d -= k1 * pd;
+        e -= k1 * pe;
+        f -= k2 * pe;
+    }
+}
+
+} // namespace
+
+StateEstimator::StateEstimator() : StateEstimator(EstimatorConfig{}) {
+}
+
+StateEstimator::StateEstimator(const EstimatorConfig& config) : config(config) {
+    reset();
+}
+
+void StateEstimator::setConfig(const EstimatorConfig& newConfig) {
+    config = newConfig;
+}
+
+void StateEstimator::reset() {
+    current = EstimatedState{};
+    position = 0.0;
+    velocity = 0.0f;
+    accel = 0.0f;
+    std::fill(std::begin(covariance), std::end(covariance), 0.0f);
+}
+
+void StateEstimator::update(double positionDeg, float omega, int64_t timeNs) {
+    const Noise noise = noiseOf(config);
+    const double zAngle = positionDeg * RAD_PER_DEG;
+    const float dt = static_cast<float>(timeNs - current.timeNs) * 1e-9f;
+
+    if (current.timeNs == 0 || dt < 0.0f || dt > MAX_GAP) {
+        // 首帧或中断后：以测量值初始化
+        position = zAngle;
+        velocity = omega;
+        accel = 0.0f;
+        covariance[0] = noise.angle;
+        covariance[1] = 0.0f;
+        covariance[2] = 0.0f;
+        covariance[3] = noise.omega;
+        covariance[4] = 0.0f;
+        covariance[5] = INITIAL_ACCEL_VARIANCE;
+    } else {
+        kalmanStep(position, velocity, accel,
+                   covariance[0], covariance[1], covariance[2], covariance[3], covariance[4], covariance[5],
+                   zAngle, omega, transitionOf(dt, config.jerkDensity), noise);
+    }
+
+    current.angle = position * DEG_PER_RAD;
+    current.omega = velocity;
+    current.acceleration = accel;
+    current.timeNs = timeNs;
+}
+
+const EstimatedState& StateEstimator::state() const {
+    return current;
+}
+
+bool StateEstimator::initialized() const {
+    return current.timeNs != 0;
+}
+
+EstimatedState StateEstimator::extrapolate(const EstimatedState& state, int64_t timeNs, float maxHorizon) {
+    if (state.timeNs == 0) {
+        return state;
+    }
+    const float h = std::clamp(static_cast<float>(timeNs - state.timeNs) * 1e-9f, 0.0f, maxHorizon);
+    EstimatedState predicted = state;
+    predicted.angle += (state.omega * h + 0.5f * state.acceleration * h * h) * DEG_PER_RAD;
+    predicted.omega += state.acceleration * h;
+    predicted.timeNs = state.timeNs + static_cast<int64_t>(h * 1e9f);
+    return predicted;
+}
+
+StateEstimatorBank::StateEstimatorBank(size_t count) : StateEstimatorBank(count, EstimatorConfig{}) {
+}
+
+StateEstimatorBank::StateEstimatorBank(size_t count, const EstimatorConfig& config) :
+    config(config),
+    initialized(false),
+    position(count, 0.0),
+    velocity(count, 0.0f),
+    accel(count, 0.0f),
+    p00(count, 0.0f), p01(count, 0.0f), p02(count, 0.0f),
+    p11(count, 0.0f), p12(count, 0.0f), p22(count, 0.0f) {
+}
+
+void StateEstimatorBank::update(const double* positionDeg, const float* omega, float dt) {
+    const Noise noise = noiseOf(config);
+    const size_t count = position.size();
+
+    if (!initialized) {
+        for (size_t i = 0; i < count; ++i) {
+            position[i] = positionDeg[i] * RAD_PER_DEG;
+            velocity[i] = omega[i];
+            accel[i] = 0.0f;
+            p00[i] = noise.angle;
+            p01[i] = p02[i] = p12[i] = 0.0f;
+            p11[i] = noise.omega;
+            p22[i] = INITIAL_ACCEL_VARIANCE;
+        }
+        initialized = true;
+        return;
+    }
+
+    // 转移矩阵与过程噪声对所有电机只算一次
+    const Transition tr = transitionOf(dt, config.jerkDensity);
+    for (size_t i = 0; i < count; ++i) {
+        kalmanStep(position[i], velocity[i], accel[i],
+                   p00[i], p01[i], p02[i], p11[i], p12[i], p22[i],
+                   positionDeg[i] * RAD_PER_DEG, omega[i], tr, noise);
+    }
+}
+
+void StateEstimatorBank::predict(float dt, double* angleDeg, float* omega) const {
+    const size_t count = position.size();
+    const float h = 0.5f * dt * dt;
+    for (size_t i = 0; i < count; ++i) {
+        angleDeg[i] = (position[i] + velocity[i] * dt + accel[i] * h) * DEG_PER_RAD;
+        omega[i] = velocity[i] + accel[i] * dt;
+    }
+}
+
+size_t StateEstimatorBank::size() const {
+    return position.size();
+}
+
+EstimatedState StateEstimatorBank::state(size_t index) const {
+    EstimatedState result;
+    result.angle = position[index] * DEG_PER_RAD;
+    result.omega = velocity[index];
+    result.acceleration = accel[index];
+    return result;
+}
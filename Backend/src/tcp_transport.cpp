@@ -0,0 +1,120 @@
+#include "tcp_transport.h"
+#include <iostream>
+#include <utility>
+
+#if defined(_MSC_VER)
+#pragma comment(lib, "ws2_32.lib")
+#endif
+
+TcpTransport::TcpTransport(std::string ipAddress, int port, const TransportOptions& options) :
+    ipAddress(std::move(ipAddress)),
+    port(port),
+    options(options),
+    sock(INVALID_SOCKET_HANDLE) {
+}
+
+TcpTransport::~TcpTransport() {
+    close();
+}
+
+bool TcpTransport::open() {
+    if (sock != INVALID_SOCKET_HANDLE) {
+        return true;
+    }
+
+    if (!initializeSockets()) {
+        std::cerr << "Socket initialization failed." << std::endl;
+        return false;
+    }
+
+    sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock == INVALID_SOCKET_HANDLE) {
+        std::cerr << "Socket creation failed." << std::endl;
+        return false;
+    }
+    applySocketOptions(sock, options, true);
+
+    sockaddr_in serverAddr{};
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, ipAddress.c_str(), &serverAddr.sin_addr) != 1) {
+        std::cerr << "Invalid address: " << ipAddress << std::endl;
+        close();
+        return false;
+    }
+
+    if (::connect(sock, reinterpret_cast<sockaddr*>(&serverAddr), sizeof(serverAddr)) < 0) {
+        std::cerr << "Connection failed." << std::endl;
+        close();
+        return false;
+    }
+
+    if (options.nonBlocking && !setSocketNonBlocking(sock, true)) {
+        std::cerr << "Warning: failed to switch socket to non-blocking mode." << std::endl;
+    }
+
+    return true;
+}
+
+void TcpTransport::close() {
+    if (sock != INVALID_SOCKET_HANDLE) {
+        closeSocket(sock);
+        sock = INVALID_SOCKET_HANDLE;
+    }
+}
+
+bool TcpTransport::isOpen() const {
+    return sock != INVALID_SOCKET_HANDLE;
+}
+
+bool TcpTransport::send(const uint8_t* data, size_t size) {
+    while (size > 0) {
+        const auto sent = ::send(sock, reinterpret_cast<const char*>(data), static_cast<int>(size), SOCKET_SEND_FLAGS);
+        if (sent < 0 && socketWouldBlock(lastSocketError())) {
+            // 非阻塞模式下发送缓冲区满，等待可写
+            pollfd_t pfd{};
+            pfd.fd = sock;
+            pfd.events = POLLOUT;
+            if (pollSockets(&pfd, 1, 100) <= 0) {
+                return false;
+            }
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+int TcpTransport::receive(uint8_t* data, size_t size, int timeoutMs) {
+    pollfd_t pfd{};
+    pfd.fd = sock;
+    pfd.events = POLLIN;
+
+    const int ready = pollSockets(&pfd, 1, timeoutMs);
+    if (ready == 0) {
+        return 0;
+    }
+    if (ready < 0) {
+        return -1;
+    }
+
+    const auto received = ::recv(sock, reinterpret_cast<char*>(data), static_cast<int>(size), 0);
+    if (received > 0) {
+        if (options.quickAck) {
+            refreshQuickAck(sock);
+        }
+        return static_cast<int>(received);
+    }
+    if (received < 0 && socketWouldBlock(lastSocketError())) {
+        return 0;
+    }
+    return -1;
+}
+
+std::string TcpTransport::describe() const {
+    return "tcp://" + ipAddress + ":" + std::to_string(port);
+}
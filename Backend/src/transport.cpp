@@ -0,0 +1,140 @@
+#include "transport.h"
+#include "serial_transport.h"
+#include "shm_transport.h"
+#include "tcp_transport.h"
+#include "udp_transport.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+
+namespace {
+
+struct ParsedUri {
+    std::string scheme;
+    std::string path;   // host:port 或设备路径
+    std::map<std::string, std::string> query;
+};
+
+bool parseUri(const std::string& uri, ParsedUri& parsed) {
+    const size_t schemeEnd = uri.find("://");
+    if (schemeEnd == std::string::npos) {
+        return false;
+    }
+    parsed.scheme = uri.substr(0, schemeEnd);
+
+    const std::string rest = uri.substr(schemeEnd + 3);
+    const size_t queryStart = rest.find('?');
+    parsed.path = rest.substr(0, queryStart);
+
+    if (queryStart != std::string::npos) {
+        std::string query = rest.substr(queryStart + 1);
+        size_t pos = 0;
+        while (pos <= query.size()) {
+            const size_t end = std::min(query.find('&', pos), query.size());
+            const std::string item = query.substr(pos, end - pos);
+            const size_t eq = item.find('=');
+            if (!item.empty()) {
+                parsed.query[item.substr(0, eq)] = eq == std::string::npos ? "1" : item.substr(eq + 1);
+            }
+            pos = end + 1;
+        }
+    }
+    return true;
+}
+
+int queryInt(const ParsedUri& parsed, const std::string& key, int fallback) {
+    const auto it = parsed.query.find(key);
+    return it != parsed.query.end() ? std::atoi(it->second.c_str()) : fallback;
+}
+
+bool splitHostPort(const std::string& path, std::string& host, int& port) {
+    const size_t colon = path.rfind(':');
+    if (colon == std::string::npos) {
+        return false;
+    }
+    host = path.substr(0, colon);
+    port = std::atoi(path.c_str() + colon + 1);
+    return !host.empty() && port > 0;
+}
+
+} // namespace
+
+std::unique_ptr<Transport> createTransport(const std::string& uri) {
+    ParsedUri parsed;
+    if (!parseUri(uri, parsed)) {
+        std::cerr << "Invalid transport URI: " << uri << std::endl;
+        return nullptr;
+    }
+
+    if (parsed.scheme == "tcp" || parsed.scheme == "udp") {
+        std::string host;
+        int port = 0;
+        if (!splitHostPort(parsed.path, host, port)) {
+            std::cerr << "Invalid address: " << parsed.path << std::endl;
+            return nullptr;
+        }
+        TransportOptions options;
+        options.tcpNoDelay = queryInt(parsed, "nodelay", options.tcpNoDelay ? 1 : 0) != 0;
+        options.quickAck = queryInt(parsed, "quickack", options.quickAck ? 1 : 0) != 0;
+        options.nonBlocking = queryInt(parsed, "nonblock", options.nonBlocking ? 1 : 0) != 0;
+        options.sendBufferSize = queryInt(parsed, "sndbuf", options.sendBufferSize);
+        options.receiveBufferSize = queryInt(parsed, "rcvbuf", options.receiveBufferSize);
+        options.busyPollUs = queryInt(parsed, "busypoll", options.busyPollUs);
+        options.priority = queryInt(parsed, "priority", options.priority);
+        if (parsed.scheme == "udp") {
+            return std::make_unique<UdpTransport>(host, port, options);
+        }
+        return std::make_unique<TcpTransport>(host, port, options);
+    }
+
+    if (parsed.scheme == "serial") {
+        SerialTransport::Options options;
+        options.baudRate = queryInt(parsed, "baud", options.baudRate);
+        options.vmin = queryInt(parsed, "vmin", options.vmin);
+        options.vtime = queryInt(parsed, "vtime", options.vtime);
+        options.lowLatency = queryInt(parsed, "lowlatency", options.lowLatency ? 1 : 0) != 0;
+        options.nonBlocking = queryInt(parsed, "nonblock", options.nonBlocking ? 1 : 0) != 0;
+        return std::make_unique<SerialTransport>(parsed.path, options);
+    }
+
+    if (parsed.scheme == "shm") {
+        if (parsed.path.empty()) {
+            std::cerr << "Missing shared memory name: " << uri << std::endl;
+            return nullptr;
+        }
+        ShmTransport::Options options;
+        options.role = parsed.query.count("role") && parsed.query["role"] == "device"
+                           ? ShmTransport::Role::DEVICE
+                           : ShmTransport::Role::CONTROLLER;
+        options.capacity = static_cast<size_t>(queryInt(parsed, "capacity", static_cast<int>(options.capacity)));
+        options.spinUs = queryInt(parsed, "spin", options.spinUs);
+        options.busyPoll = queryInt(parsed, "busypoll", options.busyPoll ? 1 : 0) != 0;
+        return std::make_unique<ShmTransport>(parsed.path, options);
+    }
+
+    std::cerr << "Unsupported transport scheme: " << parsed.scheme << std::endl;
+    return nullptr;
+}
+
+bool parseProtocolOptions(const std::string& uri, ProtocolOptions& options) {
+    ParsedUri parsed;
+    if (!parseUri(uri, parsed)) {
+        return false;
+    }
+
+    bool found = false;
+    if (parsed.query.count("protocol")) {
+        options.version = queryInt(parsed, "protocol", 1) == 2 ? ProtocolVersion::V2 : ProtocolVersion::V1;
+        found = true;
+    }
+    if (parsed.query.count("crc")) {
+        options.crc = parsed.query["crc"] == "32c" ? CrcKind::CRC32C : CrcKind::CRC16;
+        found = true;
+    }
+    if (parsed.query.count("stamp")) {
+        options.commandTimestamp = queryInt(parsed, "stamp", 0) != 0;
+        found = true;
+    }
+    return found;
+}
@@ -0,0 +1,209 @@
+#include "udp_transport.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+#if defined(_MSC_VER)
+#pragma comment(lib, "ws2_32.lib")
+#endif
+
+UdpTransport::UdpTransport(std::string ipAddress, int port, const TransportOptions& options) :
+    ipAddress(std::move(ipAddress)),
+    port(port),
+    options(options),
+    sock(INVALID_SOCKET_HANDLE),
+    sendSequence(0),
+    lastReceivedSequence(0),
+    hasReceived(false),
+    pending{},
+    pendingOffset(0),
+    pendingSize(0),
+    sent(0),
+    received(0),
+    lost(0),
+    reordered(0),
+    duplicated(0),
+    superseded(0) {
+}
+
+UdpTransport::~UdpTransport() {
+    close();
+}
+
+bool UdpTransport::open() {
+    if (sock != INVALID_SOCKET_HANDLE) {
+        return true;
+    }
+
+    if (!initializeSockets()) {
+        std::cerr << "Socket initialization failed." << std::endl;
+        return false;
+    }
+
+    sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock == INVALID_SOCKET_HANDLE) {
+        std::cerr << "Socket creation failed." << std::endl;
+        return false;
+    }
+    applySocketOptions(sock, options, false);
+
+    sockaddr_in serverAddr{};
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, ipAddress.c_str(), &serverAddr.sin_addr) != 1) {
+        std::cerr << "Invalid address: " << ipAddress << std::endl;
+        close();
+        return false;
+    }
+
+    // 绑定对端地址：之后只收该地址的数据报，send 无需再带地址
+    if (::connect(sock, reinterpret_cast<sockaddr*>(&serverAddr), sizeof(serverAddr)) < 0 ||
+        !setSocketNonBlocking(sock, true)) {
+        std::cerr << "UDP socket setup failed." << std::endl;
+        close();
+        return false;
+    }
+
+    sendSequence = 0;
+    hasReceived = false;
+    pendingOffset = 0;
+    pendingSize = 0;
+    return true;
+}
+
+void UdpTransport::close() {
+    if (sock != INVALID_SOCKET_HANDLE) {
+        closeSocket(sock);
+        sock = INVALID_SOCKET_HANDLE;
+    }
+}
+
+bool UdpTransport::isOpen() const {
+    return sock != INVALID_SOCKET_HANDLE;
+}
+
+bool UdpTransport::send(const uint8_t* data, size_t size) {
+    if (size + SEQUENCE_SIZE > MAX_DATAGRAM) {
+        return false;
+    }
+
+    uint8_t datagram[MAX_DATAGRAM];
+    const uint32_t sequence = sendSequence++;
+    datagram[0] = static_cast<uint8_t>(sequence);
+    datagram[1] = static_cast<uint8_t>(sequence >> 8);
+    datagram[2] = static_cast<uint8_t>(sequence >> 16);
+    datagram[3] = static_cast<uint8_t>(sequence >> 24);
+    std::memcpy(datagram + SEQUENCE_SIZE, data, size);
+
+    const auto result = ::send(sock, reinterpret_cast<const char*>(datagram),
+                               static_cast<int>(size + SEQUENCE_SIZE), SOCKET_SEND_FLAGS);
+    if (result < 0) {
+        // 对端尚未启动或发送缓冲区满时丢弃本包即可，UDP 不重传
+        const int error = lastSocketError();
+        return socketWouldBlock(error) || socketPeerUnreachable(error);
+    }
+    sent.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool UdpTransport::acceptSequence(uint32_t sequence) {
+    if (!hasReceived || static_cast<int32_t>(sequence - lastReceivedSequence) < -RESTART_WINDOW) {
+        hasReceived = true;
+        lastReceivedSequence = sequence;
+        return true;
+    }
+
+    const auto delta = static_cast<int32_t>(sequence - lastReceivedSequence);
+    if (delta == 0) {
+        duplicated.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (delta < 0) {
+        reordered.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (delta > 1) {
+        lost.fetch_add(static_cast<uint64_t>(delta - 1), std::memory_order_relaxed);
+    }
+    lastReceivedSequence = sequence;
+    return true;
+}
+
+int UdpTransport::receive(uint8_t* data, size_t size, int timeoutMs) {
+    // 上一个数据报还有未交付的载荷时先交付完，保证交给组帧器的字节流不缺块
+    if (pendingOffset < pendingSize) {
+        const size_t count = std::min(pendingSize - pendingOffset, size);
+        std::memcpy(data, pending + pendingOffset, count);
+        pendingOffset += count;
+        return static_cast<int>(count);
+    }
+
+    pollfd_t pfd{};
+    pfd.fd = sock;
+    pfd.events = POLLIN;
+
+    const int ready = pollSockets(&pfd, 1, timeoutMs);
+    if (ready == 0) {
+        return 0;
+    }
+    if (ready < 0) {
+        return -1;
+    }
+
+    // 读空 socket 中排队的数据报，只保留序号最新的一个
+    uint8_t datagram[MAX_DATAGRAM];
+    bool accepted = false;
+    while (true) {
+        const auto length = ::recv(sock, reinterpret_cast<char*>(datagram), static_cast<int>(sizeof(datagram)), 0);
+        if (length < 0) {
+            const int error = lastSocketError();
+            if (socketWouldBlock(error) || socketPeerUnreachable(error)) {
+                break;
+            }
+            return -1;
+        }
+        if (static_cast<size_t>(length) <= SEQUENCE_SIZE) {
+            continue;
+        }
+
+        const uint32_t sequence = static_cast<uint32_t>(datagram[0]) |
+                                  static_cast<uint32_t>(datagram[1]) << 8 |
+                                  static_cast<uint32_t>(datagram[2]) << 16 |
+                                  static_cast<uint32_t>(datagram[3]) << 24;
+        received.fetch_add(1, std::memory_order_relaxed);
+        if (!acceptSequence(sequence)) {
+            continue;
+        }
+
+        if (accepted) {
+            superseded.fetch_add(1, std::memory_order_relaxed);
+        }
+        pendingSize = static_cast<size_t>(length) - SEQUENCE_SIZE;
+        std::memcpy(pending, datagram + SEQUENCE_SIZE, pendingSize);
+        accepted = true;
+    }
+    if (!accepted) {
+        return 0;
+    }
+
+    const size_t count = std::min(pendingSize, size);
+    std::memcpy(data, pending, count);
+    pendingOffset = count;
+    return static_cast<int>(count);
+}
+
+std::string UdpTransport::describe() const {
+    return "udp://" + ipAddress + ":" + std::to_string(port);
+}
+
+TransportStats UdpTransport::stats() const {
+    TransportStats stats;
+    stats.packetsSent = sent.load(std::memory_order_relaxed);
+    stats.packetsReceived = received.load(std::memory_order_relaxed);
+    stats.packetsLost = lost.load(std::memory_order_relaxed);
+    stats.packetsReordered = reordered.load(std::memory_order_relaxed);
+    stats.packetsDuplicated = duplicated.load(std::memory_order_relaxed);
+    stats.packetsSuperseded = superseded.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,153 @@
+#include "motor.h"
+#include "packet_framer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// 串口链路回环：openpty 的从端交给 SerialTransport（serial:// URI），测试从主端扮演设备。
+// 覆盖带噪声输入的重新同步、指令下发、突发反馈填满组帧缓冲区后接收线程不断链，以及断开不阻塞
+
+namespace {
+
+constexpr uint8_t MOTOR_ID = 1;
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    std::printf("%s %s\n", condition ? "[PASS]" : "[FAIL]", what);
+    if (!condition) {
+        ++failures;
+    }
+}
+
+void appendFeedback(std::vector<uint8_t>& out, float angle, float omega) {
+    uint8_t frame[FEEDBACK_PACKET_SIZE];
+    frame[0] = FEEDBACK_HEADER;
+    frame[1] = MOTOR_ID;
+    std::memcpy(frame + 2, &angle, sizeof(angle));
+    std::memcpy(frame + 6, &omega, sizeof(omega));
+    frame[FEEDBACK_PACKET_SIZE - 1] = xorChecksum(frame, FEEDBACK_PACKET_SIZE - 1);
+    out.insert(out.end(), frame, frame + FEEDBACK_PACKET_SIZE);
+}
+
+bool writeAll(int fd, const std::vector<uint8_t>& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        const ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n < 0) {
+            pollfd pfd{fd, POLLOUT, 0};
+            if (::poll(&pfd, 1, 1000) <= 0) {
+                return false;
+            }
+            continue;
+        }
+        written += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+template <typename Predicate>
+bool waitFor(Predicate predicate, std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return predicate();
+}
+
+// 从主端读取指令流，直到出现一条力矩为 torque 的有效指令；期间持续回送反馈，避免触发反馈看门狗
+bool waitForCommand(int master, float torque) {
+    std::vector<uint8_t> stream;
+    std::vector<uint8_t> keepAlive;
+    appendFeedback(keepAlive, 0.0f, 0.0f);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    uint8_t buffer[256];
+    while (std::chrono::steady_clock::now() < deadline) {
+        writeAll(master, keepAlive);
+        pollfd pfd{master, POLLIN, 0};
+        if (::poll(&pfd, 1, 10) <= 0) {
+            continue;
+        }
+        const ssize_t n = ::read(master, buffer, sizeof(buffer));
+        if (n <= 0) {
+            continue;
+        }
+        stream.insert(stream.end(), buffer, buffer + n);
+        for (size_t i = 0; i + COMMAND_PACKET_SIZE <= stream.size(); ++i) {
+            const uint8_t* packet = stream.data() + i;
+            if (packet[0] != COMMAND_HEADER || packet[1] != MOTOR_ID ||
+                xorChecksum(packet, COMMAND_PACKET_SIZE - 1) != packet[COMMAND_PACKET_SIZE - 1]) {
+                continue;
+            }
+            float value = 0.0f;
+            std::memcpy(&value, packet + 2, sizeof(value));
+            if (value == torque) {
+                return true;
+            }
+        }
+        if (stream.size() > COMMAND_PACKET_SIZE) {
+            stream.erase(stream.begin(), stream.end() - COMMAND_PACKET_SIZE);
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+int main() {
+    int master = -1;
+    int slave = -1;
+    char slaveName[256] = {};
+    if (::openpty(&master, &slave, slaveName, nullptr, nullptr) != 0) {
+        std::perror("openpty");
+        return 1;
+    }
+    ::fcntl(master, F_SETFL, ::fcntl(master, F_GETFL) | O_NONBLOCK);
+
+    Motor motor(MOTOR_ID);
+    check(motor.connectUri(std::string("serial://") + slaveName + "?baud=115200"), "connect over serial://");
+
+    // 噪声前缀：垃圾字节与一个校验错误的包，之后的有效包仍应被解析
+    std::vector<uint8_t> noisy = {0x13, 0x37, FEEDBACK_HEADER, 0x42};
+    appendFeedback(noisy, 99.0f, 0.0f);
+    noisy[noisy.size() - 1] ^= 0xFF;
+    appendFeedback(noisy, 12.5f, 1.5f);
+    writeAll(master, noisy);
+    check(waitFor([&] { return motor.getCurrentAngle() == 12.5f && motor.getCurrentOmega() == 1.5f; },
+                  std::chrono::seconds(1)),
+          "resync after noisy prefix");
+
+    motor.setTorque(0.75f);
+    check(waitForCommand(master, 0.75f), "command reaches the device");
+
+    // 突发反馈：一次写入远超组帧缓冲区容量，接收线程会读到缓冲区尾部恰好写满、剩半个包的情况
+    bool burstsDelivered = true;
+    for (int burst = 0; burst < 20 && burstsDelivered; ++burst) {
+        std::vector<uint8_t> frames;
+        for (int i = 0; i < 100; ++i) {
+            appendFeedback(frames, static_cast<float>(burst * 100 + i), 0.0f);
+        }
+        writeAll(master, frames);
+        const float last = static_cast<float>(burst * 100 + 99);
+        burstsDelivered = waitFor([&] { return motor.getCurrentAngle() == last; }, std::chrono::seconds(1));
+    }
+    check(burstsDelivered, "link survives bursts that fill the framer buffer");
+
+    const auto start = std::chrono::steady_clock::now();
+    motor.disconnect();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    check(elapsed < std::chrono::milliseconds(500), "disconnect returns promptly");
+
+    ::close(master);
+    ::close(slave);
+    return failures == 0 ? 0 : 1;
+}
@@ -10,6 +10,7 @@ using System.Collections.Generic;
 public enum ComMethod{
     Tcp,
     Uart,
+    Udp,
 }
 
 public class MotorComServer : MonoBehaviour
@@ -17,7 +18,7 @@ public class MotorComServer : MonoBehaviour
     [Header("Communication Settings")]
     public ComMethod communicationMethod = ComMethod.Tcp;
     
-    [Header("TCP Settings")]
+    [Header("TCP / UDP Settings")]
     public int listenPort = 6000;
     
     [Header("UART Settings")]
@@ -30,6 +31,10 @@ public class MotorComServer : MonoBehaviour
     [Header("Motor Settings")]
     public byte motorId = 1; // 默认电机ID
     
+    [Header("Protocol Settings")]
+    public int protocolVersion = 1;  // 1: A0/A1 定长包 + XOR 校验；2: A2 帧 + CRC + 可选字段
+    public bool useCrc32c = false;   // v2 反馈帧使用 CRC-32C，否则 CRC-16
+    
     [Header("General Settings")]
     public float reconnectDelay = 2f;
     
@@ -38,6 +43,28 @@ public class MotorComServer : MonoBehaviour
     private const byte COMMAND_HEADER = 0xA1;
     private const int FEEDBACK_PACKET_SIZE = 11; // A0 + ID + Angle(4) + Speed(4) + Checksum
     private const int COMMAND_PACKET_SIZE = 7;   // A1 + ID + Torque(4) + Checksum
+    private const int UDP_SEQUENCE_SIZE = 4;     // UDP 数据报前的小端序号，与 Backend/include/udp_transport.h 一致
+    private const int UDP_RESTART_WINDOW = 1024; // 序号回退超过该值视为对端重新打开（上位机每次连接从 0 开始计数）
+
+    // v2 协议常量，与 Backend/include/protocol.h 中的包描述保持一致
+    // 帧格式：A2 + 版本/CRC/类型 + ID + 字段掩码 + 字段(按位序) + CRC
+    private const byte V2_HEADER = 0xA2;
+    private const byte V2_TYPE_FEEDBACK = 0;
+    private const byte V2_TYPE_COMMAND = 1;
+    private const byte V2_CRC32C_FLAG = 0x08;
+    private const int V2_PREFIX_SIZE = 4;
+    private const byte FB_ANGLE = 0x01;         // float
+    private const byte FB_OMEGA = 0x02;         // float
+    private const byte FB_DEVICE_TIME = 0x10;   // uint32，微秒
+    private const byte FB_COMMAND_TIME = 0x20;  // uint64，回显指令中的上位机时间戳
+    private const byte CMD_TORQUE = 0x01;       // float
+    private const byte CMD_HOST_TIME = 0x02;    // uint64
+
+    private static readonly ushort[] crc16Table = BuildCrc16Table();
+    private static readonly uint[] crc32cTable = BuildCrc32cTable();
+    private readonly System.Diagnostics.Stopwatch deviceClock = System.Diagnostics.Stopwatch.StartNew();
+    private ulong lastCommandTimeNs = 0;
+    private bool hasCommandTime = false;
     
     // TCP相关
     private TcpListener listener;
@@ -46,6 +73,13 @@ public class MotorComServer : MonoBehaviour
     
     // UART相关（本来想做485的结果没钱买了QAQ）
     private SerialPort serialPort;
+
+    // UDP相关：反馈发往最近一个有效命令数据报的来源地址
+    private UdpClient udpClient;
+    private IPEndPoint udpRemote;
+    private uint udpSendSequence = 0;
+    private uint udpLastSequence = 0;
+    private bool udpHasReceived = false;
     
     // 通用
     private Thread commThread;
@@ -82,6 +116,9 @@ public class MotorComServer : MonoBehaviour
             case ComMethod.Uart:
                 StartRS485();
                 break;
+            case ComMethod.Udp:
+                StartUdpServer();
+                break;
         }
     }
 
@@ -469,9 +506,128 @@ public class MotorComServer : MonoBehaviour
     }
     #endregion
     
+    #region UDP Communication
+    void StartUdpServer()
+    {
+        try
+        {
+            CleanupUdpConnection();
+
+            udpClient = new UdpClient(listenPort);
+            udpClient.Client.ReceiveTimeout = 100;
+            udpRemote = null;
+            udpSendSequence = 0;
+            udpHasReceived = false;
+            bufferPosition = 0;
+
+            running = true;
+            Debug.Log($"✓ UDP Server started on port {listenPort}, waiting for commands...");
+
+            commThread = new Thread(UdpCommLoop);
+            commThread.IsBackground = true;
+            commThread.Start();
+        }
+        catch (Exception e)
+        {
+            Debug.LogError($"✗ Failed to start UDP server: {e.Message}");
+
+            if (shouldRun)
+            {
+                Invoke("StartUdpServer", reconnectDelay);
+            }
+        }
+    }
+
+    void UdpCommLoop()
+    {
+        Debug.Log("UDP Communication started");
+
+        while (running && shouldRun)
+        {
+            try
+            {
+                IPEndPoint remote = new IPEndPoint(IPAddress.Any, 0);
+                byte[] datagram = udpClient.Receive(ref remote);
+                if (datagram.Length <= UDP_SEQUENCE_SIZE)
+                {
+                    continue;
+                }
+
+                // 与上位机相同的序号规则：乱序或重复的数据报直接丢弃，过期力矩不生效。
+                // 来源地址变化或序号大幅回退说明上位机重连 / 重启，序号从头计数，重新开始跟踪
+                uint sequence = BitConverter.ToUInt32(datagram, 0);
+                int delta = (int)(sequence - udpLastSequence);
+                bool restarted = udpRemote == null || !udpRemote.Equals(remote) || delta < -UDP_RESTART_WINDOW;
+                if (udpHasReceived && !restarted && delta <= 0)
+                {
+                    continue;
+                }
+                if (restarted)
+                {
+                    bufferPosition = 0;
+                }
+                udpHasReceived = true;
+                udpLastSequence = sequence;
+                udpRemote = remote;
+
+                int payload = Math.Min(datagram.Length - UDP_SEQUENCE_SIZE, receiveBuffer.Length - bufferPosition);
+                Array.Copy(datagram, UDP_SEQUENCE_SIZE, receiveBuffer, bufferPosition, payload);
+                bufferPosition += payload;
+                ProcessReceivedData();
+
+                // 发送反馈数据
+                SendFeedbackPacket();
+            }
+            catch (SocketException e) when (e.SocketErrorCode == SocketError.TimedOut ||
+                                            e.SocketErrorCode == SocketError.ConnectionReset)
+            {
+                // 接收超时或上位机端口已关闭（Windows 上报为 ConnectionReset），继续等待
+                continue;
+            }
+            catch (Exception e)
+            {
+                Debug.LogWarning($"UDP Communication error: {e.Message}");
+                break;
+            }
+        }
+
+        Debug.Log("UDP Communication ended");
+        CleanupUdpConnection();
+
+        if (shouldRun)
+        {
+            Invoke("StartUdpServer", reconnectDelay);
+        }
+    }
+
+    void CleanupUdpConnection()
+    {
+        running = false;
+        try
+        {
+            if (udpClient != null)
+            {
+                udpClient.Close();
+                udpClient = null;
+            }
+            udpRemote = null;
+        }
+        catch (Exception e)
+        {
+            Debug.LogWarning($"Error during UDP cleanup: {e.Message}");
+        }
+    }
+    #endregion
+
     #region Packet Processing
     void ProcessReceivedData()
     {
+        if (protocolVersion == 2)
+        {
+            ProcessReceivedDataV2();
+            return;
+        }
+
         while (bufferPosition >= COMMAND_PACKET_SIZE)
         {
             // 查找命令包头
@@ -545,40 +701,211 @@ public class MotorComServer : MonoBehaviour
         }
     }
 
+    void ProcessReceivedDataV2()
+    {
+        int start = 0;
+        while (bufferPosition - start >= V2_PREFIX_SIZE + 2)
+        {
+            if (receiveBuffer[start] != V2_HEADER)
+            {
+                start++;
+                continue;
+            }
+
+            byte version = receiveBuffer[start + 1];
+            byte mask = receiveBuffer[start + 3];
+            if ((version >> 4) != 2 || (version & 0x07) != V2_TYPE_COMMAND || (mask & ~(CMD_TORQUE | CMD_HOST_TIME)) != 0)
+            {
+                start++;
+                continue;
+            }
+
+            bool crc32 = (version & V2_CRC32C_FLAG) != 0;
+            int body = V2_PREFIX_SIZE + ((mask & CMD_TORQUE) != 0 ? 4 : 0) + ((mask & CMD_HOST_TIME) != 0 ? 8 : 0);
+            int frame = body + (crc32 ? 4 : 2);
+            if (bufferPosition - start < frame)
+            {
+                // 数据不足，等待更多数据
+                break;
+            }
+
+            bool valid = crc32
+                ? Crc32c(receiveBuffer, start, body) == BitConverter.ToUInt32(receiveBuffer, start + body)
+                : Crc16(receiveBuffer, start, body) == BitConverter.ToUInt16(receiveBuffer, start + body);
+            if (!valid)
+            {
+                Debug.LogWarning($"CRC error in command frame at position {start}");
+                start++;
+                continue;
+            }
+
+            // 只处理本电机ID的数据
+            if (receiveBuffer[start + 2] == motorId)
+            {
+                int offset = start + V2_PREFIX_SIZE;
+                if ((mask & CMD_TORQUE) != 0)
+                {
+                    motorSim.motors[motorId].torqueInput = BitConverter.ToSingle(receiveBuffer, offset);
+                    offset += 4;
+                }
+                if ((mask & CMD_HOST_TIME) != 0)
+                {
+                    lastCommandTimeNs = BitConverter.ToUInt64(receiveBuffer, offset);
+                    hasCommandTime = true;
+                }
+            }
+            start += frame;
+        }
+
+        // 移除已处理的数据
+        if (start > 0)
+        {
+            Array.Copy(receiveBuffer, start, receiveBuffer, 0, bufferPosition - start);
+            bufferPosition -= start;
+        }
+    }
+
+    byte[] BuildFeedbackPacketV1()
+    {
+        byte[] packet = new byte[FEEDBACK_PACKET_SIZE];
+        
+        // 包头
+        packet[0] = FEEDBACK_HEADER;
+        // 电机ID
+        packet[1] = motorId;
+        // 角度数据（转换为度）
+        Buffer.BlockCopy(BitConverter.GetBytes(motorSim.motors[motorId].angle * Mathf.Rad2Deg), 0, packet, 2, 4);
+        // 速度数据
+        Buffer.BlockCopy(BitConverter.GetBytes(motorSim.motors[motorId].angularVelocity), 0, packet, 6, 4);
+        
+        // 计算校验和
+        byte checksum = 0;
+        for (int i = 0; i < FEEDBACK_PACKET_SIZE - 1; i++)
+        {
+            checksum ^= packet[i];
+        }
+        packet[FEEDBACK_PACKET_SIZE - 1] = checksum;
+        return packet;
+    }
+
+    byte[] BuildFeedbackPacketV2()
+    {
+        byte mask = FB_ANGLE | FB_OMEGA | FB_DEVICE_TIME;
+        if (hasCommandTime)
+        {
+            mask |= FB_COMMAND_TIME;
+        }
+
+        int body = V2_PREFIX_SIZE + 12 + (hasCommandTime ? 8 : 0);
+        byte[] packet = new byte[body + (useCrc32c ? 4 : 2)];
+        packet[0] = V2_HEADER;
+        packet[1] = (byte)((2 << 4) | (useCrc32c ? V2_CRC32C_FLAG : 0) | V2_TYPE_FEEDBACK);
+        packet[2] = motorId;
+        packet[3] = mask;
+
+        // 字段按位序排列
+        int offset = V2_PREFIX_SIZE;
+        Buffer.BlockCopy(BitConverter.GetBytes(motorSim.motors[motorId].angle * Mathf.Rad2Deg), 0, packet, offset, 4);
+        offset += 4;
+        Buffer.BlockCopy(BitConverter.GetBytes(motorSim.motors[motorId].angularVelocity), 0, packet, offset, 4);
+        offset += 4;
+        uint deviceTimeUs = (uint)(deviceClock.Elapsed.Ticks / 10);  // TimeSpan 刻度为 100ns
+        Buffer.BlockCopy(BitConverter.GetBytes(deviceTimeUs), 0, packet, offset, 4);
+        offset += 4;
+        if (hasCommandTime)
+        {
+            Buffer.BlockCopy(BitConverter.GetBytes(lastCommandTimeNs), 0, packet, offset, 8);
+        }
+
+        if (useCrc32c)
+        {
+            Buffer.BlockCopy(BitConverter.GetBytes(Crc32c(packet, 0, body)), 0, packet, body, 4);
+        }
+        else
+        {
+            Buffer.BlockCopy(BitConverter.GetBytes(Crc16(packet, 0, body)), 0, packet, body, 2);
+        }
+        return packet;
+    }
+
+    // CRC-16/CCITT-FALSE
+    static ushort[] BuildCrc16Table()
+    {
+        ushort[] table = new ushort[256];
+        for (int i = 0; i < 256; i++)
+        {
+            ushort crc = (ushort)(i << 8);
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (ushort)((crc & 0x8000) != 0 ? (crc << 1) ^ 0x1021 : crc << 1);
+            }
+            table[i] = crc;
+        }
+        return table;
+    }
+
+    static ushort Crc16(byte[] data, int offset, int count)
+    {
+        ushort crc = 0xFFFF;
+        for (int i = 0; i < count; i++)
+        {
+            crc = (ushort)((crc << 8) ^ crc16Table[((crc >> 8) ^ data[offset + i]) & 0xFF]);
+        }
+        return crc;
+    }
+
+    // CRC-32C (Castagnoli)，反射多项式 0x82F63B78
+    static uint[] BuildCrc32cTable()
+    {
+        uint[] table = new uint[256];
+        for (uint i = 0; i < 256; i++)
+        {
+            uint crc = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 1) != 0 ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+            }
+            table[i] = crc;
+        }
+        return table;
+    }
+
+    static uint Crc32c(byte[] data, int offset, int count)
+    {
+        uint crc = 0xFFFFFFFFu;
+        for (int i = 0; i < count; i++)
+        {
+            crc = (crc >> 8) ^ crc32cTable[(crc ^ data[offset + i]) & 0xFF];
+        }
+        return ~crc;
+    }
+
     void SendFeedbackPacket()
     {
         if ((communicationMethod == ComMethod.Tcp && (client == null || !client.Connected)) ||
-            (communicationMethod == ComMethod.Uart && (serialPort == null || !serialPort.IsOpen)))
+            (communicationMethod == ComMethod.Uart && (serialPort == null || !serialPort.IsOpen)) ||
+            (communicationMethod == ComMethod.Udp && (udpClient == null || udpRemote == null)))
         {
             return;
         }
 
         try
         {
-            byte[] packet = new byte[FEEDBACK_PACKET_SIZE];
-            
-            // 包头
-            packet[0] = FEEDBACK_HEADER;
-            // 电机ID
-            packet[1] = motorId;
-            // 角度数据（转换为度）
-            Buffer.BlockCopy(BitConverter.GetBytes(motorSim.motors[motorId].angle * Mathf.Rad2Deg), 0, packet, 2, 4);
-            // 速度数据
-            Buffer.BlockCopy(BitConverter.GetBytes(motorSim.motors[motorId].angularVelocity), 0, packet, 6, 4);
-            
-            // 计算校验和
-            byte checksum = 0;
-            for (int i = 0; i < FEEDBACK_PACKET_SIZE - 1; i++)
-            {
-                checksum ^= packet[i];
-            }
-            packet[FEEDBACK_PACKET_SIZE - 1] = checksum;
+            byte[] packet = protocolVersion == 2 ? BuildFeedbackPacketV2() : BuildFeedbackPacketV1();
 
             // 发送数据
             if (communicationMethod == ComMethod.Tcp)
             {
                 stream.Write(packet, 0, packet.Length);
             }
+            else if (communicationMethod == ComMethod.Udp)
+            {
+                // 数据报 = 4 字节小端序号 + 反馈包
+                byte[] datagram = new byte[UDP_SEQUENCE_SIZE + packet.Length];
+                Buffer.BlockCopy(BitConverter.GetBytes(udpSendSequence++), 0, datagram, 0, UDP_SEQUENCE_SIZE);
+                Buffer.BlockCopy(packet, 0, datagram, UDP_SEQUENCE_SIZE, packet.Length);
+                udpClient.Send(datagram, datagram.Length, udpRemote);
+            }
             else
             {
                 serialPort.Write(packet, 0, packet.Length);
@@ -646,6 +973,9 @@ public class MotorComServer : MonoBehaviour
             case ComMethod.Uart:
                 CleanupRS485Connection();
                 break;
+            case ComMethod.Udp:
+                CleanupUdpConnection();
+                break;
         }
 
         Debug.Log("=== Cleanup completed ===");
@@ -678,6 +1008,12 @@ public class MotorComServer : MonoBehaviour
                 }
             }
         }
+        else if (communicationMethod == ComMethod.Udp)
+        {
+            status += $"UDP Socket: {(udpClient != null ? "Open" : "Closed")}\n";
+            status += $"Current Port: {listenPort}\n";
+            status += $"Remote Endpoint: {(udpRemote != null ? udpRemote.ToString() : "None")}\n";
+        }
         else
         {
             status += $"Serial Port: {(serialPort != null && serialPort.IsOpen ? "Open" : "Closed")}\n";
@@ -737,6 +1073,15 @@ public class MotorComServer : MonoBehaviour
         return serialPort != null && serialPort.IsOpen && running;
     }
 
+    /// <summary>
+    /// 检查UDP是否已收到上位机的命令数据报
+    /// </summary>
+    /// <returns>如果已知上位机地址返回true</returns>
+    public bool IsUdpPeerKnown()
+    {
+        return udpClient != null && udpRemote != null && running;
+    }
+
     /// <summary>
     /// 获取当前连接状态
     /// </summary>
@@ -749,6 +1094,8 @@ public class MotorComServer : MonoBehaviour
                 return IsClientConnected();
             case ComMethod.Uart:
                 return IsSerialPortOpen();
+            case ComMethod.Udp:
+                return IsUdpPeerKnown();
             default:
                 return false;
         }
@@ -782,6 +1129,13 @@ public class MotorComServer : MonoBehaviour
                     return $"RS485: {serialPortName} @ {baudRate} baud";
                 }
                 return $"RS485: Disconnected ({serialPortName})";
+
+            case ComMethod.Udp:
+                if (IsUdpPeerKnown())
+                {
+                    return $"UDP Peer: {udpRemote}";
+                }
+                return $"UDP Server: Listening on port {listenPort}";
                 
             default:
                 return "Unknown method";
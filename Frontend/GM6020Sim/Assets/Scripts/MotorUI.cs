@@ -254,6 +254,9 @@ public class MotorUI : MonoBehaviour
             case ComMethod.Uart:
                 communicationMethodText.color = new Color(0f, 1f, 0f, 1f); // 紫色
                 break;
+            case ComMethod.Udp:
+                communicationMethodText.color = new Color(0.5f, 0.8f, 1f, 1f); // 浅蓝
+                break;
         }
     }
     
@@ -277,6 +280,10 @@ public class MotorUI : MonoBehaviour
             case ComMethod.Uart:
                 portInfo = $"Serial: {motorComServer.serialPortName} | {motorComServer.baudRate} baud";
                 break;
+
+            case ComMethod.Udp:
+                portInfo = $"UDP Port: {motorComServer.listenPort}";
+                break;
         }
 
         portInfoText.text = portInfo;
@@ -315,11 +322,15 @@ public class MotorUI : MonoBehaviour
     {
         if (motorComServer != null)
         {
-            // 切换通信方式
+            // 切换通信方式：TCP → UART → UDP → TCP
             if (motorComServer.communicationMethod == ComMethod.Tcp)
             {
                 motorComServer.communicationMethod = ComMethod.Uart;
             }
+            else if (motorComServer.communicationMethod == ComMethod.Uart)
+            {
+                motorComServer.communicationMethod = ComMethod.Udp;
+            }
             else
             {
                 motorComServer.communicationMethod = ComMethod.Tcp;